@@ -0,0 +1,213 @@
+// ======================================================================== //
+// Copyright 2021 Michel Fäh
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ======================================================================== //
+
+// Compares decodeInt() against the previous digit by digit decoder. Build it
+// with -DBASS_BUILD_BENCHMARKS=ON and run ./bench/literalBench
+
+#include "literal.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+/** Amount of literals of every benchmark row */
+constexpr uint32_t LITERAL_COUNT = 2000000;
+/** Every row is timed this many times and the best run is reported */
+constexpr uint32_t RUN_COUNT = 7;
+/** Padding behind the last literal which decodeInt() is allowed to read */
+constexpr uint32_t LITERAL_PADDING = 32;
+
+/**
+ * Position of a literal in the benchmark buffer
+ */
+struct LiteralSpan {
+    uint32_t Index;
+    uint32_t Size;
+};
+
+/**
+ * Literals of one benchmark row stored back to back, separated by commas
+ */
+struct LiteralSet {
+    std::vector<uint8_t> Buffer;
+    std::vector<LiteralSpan> Spans;
+};
+
+typedef bool (*IntDecoder)(const uint8_t* begin,
+                           const uint8_t* end,
+                           uint64_t& num);
+
+/**
+ * Decodes an integer one digit at a time. This is the decoder decodeInt()
+ * replaced and serves as the baseline
+ * @param begin Pointer to the first char of the number string
+ * @param end Pointer behind the last char of the number string
+ * @param num [out] Decoded integer
+ * @return If integer fits into a 64-bit integer returns true otherwise false
+ */
+static bool decodeIntSerial(const uint8_t* begin,
+                            const uint8_t* end,
+                            uint64_t& num) {
+    num = 0;
+
+    if (end - begin > 2 && begin[0] == '0' && begin[1] == 'x') {
+        for (const uint8_t* c = &begin[2]; c < end; c++) {
+            // The 4 highest bits would be shifted out
+            if (num >> 60 != 0) {
+                return false;
+            }
+
+            uint8_t digit = *c - '0';
+            if (*c >= 'a') {
+                digit = *c - 'a' + 10;
+            } else if (*c >= 'A') {
+                digit = *c - 'A' + 10;
+            }
+            num = (num << 4) | digit;
+        }
+        return true;
+    }
+
+    for (const uint8_t* c = begin; c < end; c++) {
+        uint64_t digit = *c - '0';
+        if (num > (UINT64_MAX - digit) / 10) {
+            return false;
+        }
+        num = num * 10 + digit;
+    }
+    return true;
+}
+
+/**
+ * Creates the literals of a benchmark row
+ * @param kind Index of the row
+ * @param rng Random number generator
+ * @return Literals
+ */
+static LiteralSet createLiterals(uint32_t kind, std::mt19937_64& rng) {
+    LiteralSet set;
+    for (uint32_t i = 0; i < LITERAL_COUNT; i++) {
+        char str[32] = {};
+        uint64_t value = rng();
+        switch (kind) {
+        case 0:
+            std::snprintf(str, sizeof(str), "%llu",
+                          (unsigned long long)(value % 1000));
+            break;
+        case 1:
+            std::snprintf(str, sizeof(str), "%llu",
+                          (unsigned long long)(value >> (rng() % 64)));
+            break;
+        case 2:
+            std::snprintf(str, sizeof(str), "%llu",
+                          (unsigned long long)(value | (1ull << 63)));
+            break;
+        case 3:
+            std::snprintf(str, sizeof(str), "0x%llx",
+                          (unsigned long long)(value >> (rng() % 64)));
+            break;
+        default:
+            std::snprintf(str, sizeof(str), "0x%016llx",
+                          (unsigned long long)value);
+            break;
+        }
+
+        std::string lit = str;
+        uint32_t index = set.Buffer.size();
+        set.Spans.push_back({index, (uint32_t)lit.size()});
+        set.Buffer.insert(set.Buffer.end(), lit.begin(), lit.end());
+        set.Buffer.push_back(',');
+    }
+    set.Buffer.resize(set.Buffer.size() + LITERAL_PADDING, 0);
+    return set;
+}
+
+/**
+ * Times a decoder on all literals of a row
+ * @param set Literals
+ * @param decode Decoder
+ * @param sum [out] Sum of the decoded values which keeps them alive
+ * @return Best time per literal in nanoseconds
+ */
+static double
+timeDecoder(const LiteralSet& set, IntDecoder decode, uint64_t& sum) {
+    double best = 1e30;
+    for (uint32_t run = 0; run < RUN_COUNT; run++) {
+        auto start = std::chrono::steady_clock::now();
+        for (const LiteralSpan& span : set.Spans) {
+            const uint8_t* lit = &set.Buffer[span.Index];
+            uint64_t num = 0;
+            decode(lit, lit + span.Size, num);
+            sum += num;
+        }
+        auto stop = std::chrono::steady_clock::now();
+        std::chrono::duration<double> time = stop - start;
+        best = std::min(best, time.count());
+    }
+    return best * 1e9 / set.Spans.size();
+}
+
+/**
+ * Counts the literals which the two decoders decode differently
+ * @param set Literals
+ * @return Amount of mismatches
+ */
+static uint32_t countMismatches(const LiteralSet& set) {
+    uint32_t mismatches = 0;
+    for (const LiteralSpan& span : set.Spans) {
+        const uint8_t* lit = &set.Buffer[span.Index];
+        uint64_t serial = 0;
+        uint64_t chunked = 0;
+        bool serialFits = decodeIntSerial(lit, lit + span.Size, serial);
+        bool chunkedFits = decodeInt(lit, lit + span.Size, chunked);
+        if (serialFits != chunkedFits || serial != chunked) {
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+int main() {
+    const char* rowNames[] = {"dec 1-3 digits", "dec 1-20 digits",
+                              "dec 19-20 digits", "hex 0x + 1-16",
+                              "hex 0x + 16"};
+    std::mt19937_64 rng(7);
+    uint64_t sum = 0;
+    bool valid = true;
+
+    std::printf("%-18s %10s %10s %8s\n", "literals", "serial", "chunked",
+                "speedup");
+    for (uint32_t kind = 0; kind < 5; kind++) {
+        LiteralSet set = createLiterals(kind, rng);
+        if (countMismatches(set) != 0) {
+            std::printf("%-18s decoders disagree\n", rowNames[kind]);
+            valid = false;
+            continue;
+        }
+
+        double serial = timeDecoder(set, decodeIntSerial, sum);
+        double chunked = timeDecoder(set, decodeInt, sum);
+        std::printf("%-18s %7.2f ns %7.2f ns %7.2fx\n", rowNames[kind], serial,
+                    chunked, serial / chunked);
+    }
+
+    // Print the sum so that the decoded values are not optimized away
+    std::printf("checksum %llu\n", (unsigned long long)sum);
+    return valid ? 0 : 1;
+}
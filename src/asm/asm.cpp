@@ -17,65 +17,65 @@
 #include "asm.hpp"
 #include "encoding.hpp"
 #include <cstdint>
-#include <vector>
+#include <cstring>
 
 /**
- * InstrDefNode move constructor
- * @param instrDefNode Right value reference of InstrDefNode to be moved
+ * Checks that the generated signature of every parameter list matches its
+ * parameters
+ * @return If all signatures match returns true otherwise false
  */
-InstrDefNode::InstrDefNode(InstrDefNode&& instrDefNode) noexcept {
-    Type = instrDefNode.Type;
-    Children = std::move(instrDefNode.Children);
-    ParamList = instrDefNode.ParamList;
+static constexpr bool checkSignatures() {
+    for (const InstrParamList& paramList : Asm::INSTR_PARAM_LISTS) {
+        uint32_t kinds = 0;
+        for (uint32_t i = 0; i < paramList.ParamCount; i++) {
+            OperandKind kind = getParamKind(paramList.Params[i]);
+            kinds = packOperandKind(kinds, kind, i);
+        }
+        if (kinds != paramList.Signature) {
+            return false;
+        }
+    }
+    return true;
 }
+static_assert(checkSignatures(),
+              "encoding.hpp is out of date, rerun encodingData.js");
 
 /**
- * InstrDefNode constructor
- * @param type Paramter type
- * @param paramList Pointer to encoding information if this is an end node of
- * the instruction signature otherwise pass nullptr
+ * Finds the parameter list of an instruction which accepts the given operands
+ * @param instrIndex Index of the instruction
+ * @param kinds Packed kinds of the operands
+ * @return Pointer to the parameter list or nullptr if no list matches
  */
-InstrDefNode::InstrDefNode(InstrParamType type, InstrParamList* paramList)
-    : Type(type), ParamList(paramList) {}
+const InstrParamList* findInstrSignature(uint8_t instrIndex, uint32_t kinds) {
+    // Instructions have at most a few parameter lists
+    uint32_t end = Asm::INSTR_PARAM_LIST_INDEX[instrIndex + 1];
+    for (uint32_t i = Asm::INSTR_PARAM_LIST_INDEX[instrIndex]; i < end; i++) {
+        if (Asm::INSTR_PARAM_LISTS[i].Signature == kinds) {
+            return &Asm::INSTR_PARAM_LISTS[i];
+        }
+    }
+    return nullptr;
+}
 
 /**
- * Builds the tree data struct used for instruction resolution
- * @param target Output instruction definitions tree
+ * Looks up a keyword in the keyword perfect hash table
+ * @param str Pointer to string
+ * @param size Size of string
+ * @return Pointer to keyword entry or nullptr if the string is not a keyword
  */
-void buildInstrDefTree(std::vector<InstrDefNode>& target) {
-    for (const auto& def : Asm::INSTR_ASM_DEFS) {
-        InstrDefNode instr{};
-        for (const InstrParamList& paramList : def) {
-            // Keeps track of the current parent node where the children will be
-            // appended
-            InstrDefNode* parent = &instr;
-            for (const InstrParamType paramType : paramList.Params) {
-                // Check if param type is already a child of the current cursor
-                // node. If existingChild is a nullptr no already existing
-                // children were found.
-                InstrDefNode* existingChild = nullptr;
-                for (uint32_t i = 0; i < parent->Children.size(); i++) {
-                    InstrParamType type = parent->Children[i].Type;
-                    if (type == paramType) {
-                        existingChild = &parent->Children[i];
-                        break;
-                    }
-                }
+const KeywordEntry* findKeyword(const char* str, uint32_t size) {
+    if (size > Asm::KEYWORD_MAX_SIZE) {
+        return nullptr;
+    }
 
-                if (existingChild == nullptr) {
-                    // If parent does not already have this type as a child add
-                    // it
-                    parent->Children.emplace_back(paramType, nullptr);
-                    // Set parent to last pushed child
-                    parent = &parent->Children[parent->Children.size() - 1];
-                } else {
-                    parent = existingChild;
-                }
-            }
-            // After adding the last node of the branch add pointer to encoding
-            // information
-            parent->ParamList = (InstrParamList*)&paramList;
-        }
-        target.emplace_back(std::move(instr));
+    uint32_t hash = keywordHash(str, size, Asm::KEYWORD_HASH_SEED);
+    uint32_t bucket = hash & (Asm::KEYWORD_BUCKET_COUNT - 1);
+    uint32_t slot = ((hash >> 16) + Asm::KEYWORD_DISPLACEMENTS[bucket]) &
+                    (Asm::KEYWORD_TABLE_SIZE - 1);
+
+    const KeywordEntry* entry = &Asm::KEYWORD_TABLE[slot];
+    if (entry->Size != size || std::memcmp(entry->Name, str, size) != 0) {
+        return nullptr;
     }
+    return entry;
 }
@@ -15,11 +15,8 @@
 // ======================================================================== //
 
 #pragma once
-#include <array>
+#include "../token.hpp"
 #include <cstdint>
-#include <map>
-#include <string>
-#include <vector>
 
 // UVM type definitions
 constexpr uint8_t UVM_TYPE_I8 = 0x01;
@@ -33,25 +30,13 @@ constexpr uint8_t UVM_TYPE_F64 = 0xF1;
 // variables. Range 0xB0 - 0xBF is reserved for BASS types
 constexpr uint8_t BASS_TYPE_STRING = 0xB0;
 
-// This map is used to lookup valid type defs
-const static std::map<std::string, uint8_t> UVM_TYPE_DEFS{
-    {"i8", UVM_TYPE_I8},
-    {"i16", UVM_TYPE_I16},
-    {"i32", UVM_TYPE_I32},
-    {"i64", UVM_TYPE_I64},
-    {"f32", UVM_TYPE_F32},
-    {"f64", UVM_TYPE_F64},
-    // BASS types
-    {"str", BASS_TYPE_STRING},
-};
-
 // Flags that are used to encode the instructions
 constexpr uint8_t INSTR_FLAG_ENCODE_TYPE =
     0b0000'0001; // Type should be encoded into bytecode
 constexpr uint8_t INSTR_FLAG_TYPE_VARIANTS =
     0b0000'0010; // Instruction has opcode variants depending on the uvm type
 
-enum class InstrParamType {
+enum class InstrParamType : uint8_t {
     INT_TYPE,
     FLOAT_TYPE,
     FUNC_ID,
@@ -69,27 +54,124 @@ struct TypeVariant {
     uint8_t Opcode;
 };
 
+/** Maximum amount of parameters of an instruction definition */
+constexpr uint32_t MAX_INSTR_PARAMS = 3;
+/** Maximum amount of opcode variants of an instruction definition */
+constexpr uint32_t MAX_TYPE_VARIANTS = 4;
+
 struct InstrParamList {
     uint8_t Opcode;
     uint8_t Flags;
-    std::vector<InstrParamType> Params;
-    std::vector<TypeVariant> OpcodeVariants;
+    /**
+     * Index of the first encoder of this form in INSTR_ENCODERS. Forms with an
+     * immediate have one encoder per data type
+     */
+    uint8_t Encoder;
+    /** Packed operand kinds of the parameters, see packOperandKind() */
+    uint32_t Signature;
+    uint8_t ParamCount;
+    InstrParamType Params[MAX_INSTR_PARAMS];
+    uint8_t VariantCount;
+    TypeVariant OpcodeVariants[MAX_TYPE_VARIANTS];
+};
+
+/**
+ * Kind of an instruction operand. Every parameter type accepts exactly one kind
+ * of operand which allows to match all parameters of an instruction at once.
+ * The values must match PARAM_KINDS in encodingData.js
+ */
+enum class OperandKind : uint8_t {
+    NONE,
+    INT_TYPE,
+    FLOAT_TYPE,
+    LABEL,
+    FUNCTION,
+    INT_REG,
+    FLOAT_REG,
+    REG_OFFSET,
+    INT_NUM,
+    FLOAT_NUM,
+    /** Operand which no parameter type accepts like the str type */
+    INVALID,
 };
 
+/** Amount of bits of every operand kind in a packed signature */
+constexpr uint32_t SIGNATURE_KIND_BITS = 4;
+/** Maximum amount of operand kinds a packed signature holds */
+constexpr uint32_t MAX_SIGNATURE_PARAMS = 32 / SIGNATURE_KIND_BITS;
+
+/**
+ * Adds an operand kind to a packed signature
+ * @param kinds Packed signature of the preceding operands
+ * @param kind Kind of the operand
+ * @param index Index of the operand
+ * @return Packed signature which includes the operand
+ */
+constexpr uint32_t
+packOperandKind(uint32_t kinds, OperandKind kind, uint32_t index) {
+    return kinds | ((uint32_t)kind << (index * SIGNATURE_KIND_BITS));
+}
+
 /**
- * This data structured represents a paramter node of an instruction signature
+ * Returns the kind of operand which a parameter type accepts
+ * @param type Parameter type
+ * @return Operand kind
  */
-struct InstrDefNode {
-    InstrDefNode() = default;
-    InstrDefNode(InstrDefNode&& instrDefNode) noexcept;
-    InstrDefNode(InstrParamType type, InstrParamList* paramList);
-    /** UVM type of the instruction parameter */
-    InstrParamType Type = InstrParamType::INT_NUM;
-    /** Parameters which can possibly follow this parameter */
-    std::vector<InstrDefNode> Children;
-    /** If this parameter is the last of a branch this contains a pointer to the
-     * encoding information otherwise is a nullptr */
-    InstrParamList* ParamList = nullptr;
+constexpr OperandKind getParamKind(InstrParamType type) {
+    switch (type) {
+    case InstrParamType::INT_TYPE:
+        return OperandKind::INT_TYPE;
+    case InstrParamType::FLOAT_TYPE:
+        return OperandKind::FLOAT_TYPE;
+    case InstrParamType::FUNC_ID:
+        return OperandKind::FUNCTION;
+    case InstrParamType::LABEL_ID:
+        return OperandKind::LABEL;
+    case InstrParamType::INT_REG:
+        return OperandKind::INT_REG;
+    case InstrParamType::FLOAT_REG:
+        return OperandKind::FLOAT_REG;
+    case InstrParamType::REG_OFFSET:
+        return OperandKind::REG_OFFSET;
+    case InstrParamType::INT_NUM:
+    case InstrParamType::SYS_INT:
+        return OperandKind::INT_NUM;
+    case InstrParamType::FLOAT_NUM:
+        return OperandKind::FLOAT_NUM;
+    }
+    return OperandKind::INVALID;
+}
+
+/**
+ * Entry of the keyword perfect hash table. Keywords are instruction names, type
+ * names and register names
+ */
+struct KeywordEntry {
+    /** Keyword string or nullptr if the slot is empty */
+    const char* Name = nullptr;
+    /** Size of the keyword string */
+    uint8_t Size = 0;
+    /** Token type of the keyword */
+    TokenType Type = TokenType::IDENTIFIER;
+    /** Instruction index, type id or register id */
+    uint8_t Tag = 0;
 };
 
-void buildInstrDefTree(std::vector<InstrDefNode>& target);
+/**
+ * Hashes a keyword (32-bit FNV-1a seeded with the string size). This must
+ * produce the same result as keywordHash() in encodingData.js
+ * @param str Pointer to string
+ * @param size Size of string
+ * @param seed Hash seed
+ * @return Hash value
+ */
+constexpr uint32_t keywordHash(const char* str, uint32_t size, uint32_t seed) {
+    uint32_t hash = seed ^ size;
+    for (uint32_t i = 0; i < size; i++) {
+        hash = (hash ^ static_cast<uint8_t>(str[i])) * 0x01000193;
+    }
+    return hash;
+}
+
+const InstrParamList* findInstrSignature(uint8_t instrIndex, uint32_t kinds);
+const KeywordEntry* findKeyword(const char* str, uint32_t size);
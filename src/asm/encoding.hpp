@@ -15,873 +15,1428 @@
 // ======================================================================== //
 
 #pragma once
+#include "../encoder.hpp"
+#include "../token.hpp"
 #include "asm.hpp"
 #include <array>
 #include <cstdint>
-#include <map>
-#include <string>
-#include <vector>
 
 /*
     THIS FILE IS GENERATED BY THE SCRIPT 'encodingData.js' DO NOT MODIFY!
 */
 
-const std::map<std::string, uint8_t> ASM_REGISTERS{
-    {"ip", 0x1},   {"sp", 0x2},   {"bp", 0x3},   {"r0", 0x5},   {"r1", 0x6},
-    {"r2", 0x7},   {"r3", 0x8},   {"r4", 0x9},   {"r5", 0xA},   {"r6", 0xB},
-    {"r7", 0xC},   {"r8", 0xD},   {"r9", 0xE},   {"r10", 0xF},  {"r11", 0x10},
-    {"r12", 0x11}, {"r13", 0x12}, {"r14", 0x13}, {"r15", 0x14}, {"f0", 0x16},
-    {"f1", 0x17},  {"f2", 0x18},  {"f3", 0x19},  {"f4", 0x1A},  {"f5", 0x1B},
-    {"f6", 0x1C},  {"f7", 0x1D},  {"f8", 0x1E},  {"f9", 0x1F},  {"f10", 0x20},
-    {"f11", 0x21}, {"f12", 0x22}, {"f13", 0x23}, {"f14", 0x24}, {"f15", 0x25},
-};
-
 namespace Asm {
-const std::map<std::string, uint8_t> INSTR_NAMES{
-    {"nop", 0},   {"push", 1},   {"pop", 2},   {"load", 3},  {"loadf", 4},
-    {"store", 5}, {"storef", 6}, {"copy", 7},  {"copyf", 8}, {"exit", 9},
-    {"call", 10}, {"ret", 11},   {"sys", 12},  {"lea", 13},  {"add", 14},
-    {"addf", 15}, {"sub", 16},   {"subf", 17}, {"mul", 18},  {"mulf", 19},
-    {"muls", 20}, {"div", 21},   {"divf", 22}, {"divs", 23}, {"sqrt", 24},
-    {"mod", 25},  {"and", 26},   {"or", 27},   {"xor", 28},  {"not", 29},
-    {"lsh", 30},  {"rsh", 31},   {"srsh", 32}, {"b2l", 33},  {"s2l", 34},
-    {"i2l", 35},  {"b2sl", 36},  {"s2sl", 37}, {"i2sl", 38}, {"f2d", 39},
-    {"d2f", 40},  {"i2f", 41},   {"i2d", 42},  {"f2i", 43},  {"d2i", 44},
-    {"cmp", 45},  {"cmpf", 46},  {"jmp", 47},  {"je", 48},   {"jne", 49},
-    {"jgt", 50},  {"jlt", 51},   {"jge", 52},  {"jle", 53},
+// Encoder of every instruction form and immediate width
+constexpr std::array<InstrEncoding, 42> INSTR_ENCODERS{{
+    // 0: ()
+    makeEncoding<>(),
+    // 1: (iT, int)
+    makeEncoding<
+        OperandEncoding::NONE,
+        OperandEncoding::I8>(),
+    // 2: (iT, int)
+    makeEncoding<
+        OperandEncoding::NONE,
+        OperandEncoding::I16>(),
+    // 3: (iT, int)
+    makeEncoding<
+        OperandEncoding::NONE,
+        OperandEncoding::I32>(),
+    // 4: (iT, int)
+    makeEncoding<
+        OperandEncoding::NONE,
+        OperandEncoding::I64>(),
+    // 5: (iT, iReg)
+    makeEncoding<
+        OperandEncoding::TYPE,
+        OperandEncoding::REG>(),
+    // 6: (iT)
+    makeEncoding<
+        OperandEncoding::TYPE>(),
+    // 7: (iT, int, iReg)
+    makeEncoding<
+        OperandEncoding::NONE,
+        OperandEncoding::I8,
+        OperandEncoding::REG>(),
+    // 8: (iT, int, iReg)
+    makeEncoding<
+        OperandEncoding::NONE,
+        OperandEncoding::I16,
+        OperandEncoding::REG>(),
+    // 9: (iT, int, iReg)
+    makeEncoding<
+        OperandEncoding::NONE,
+        OperandEncoding::I32,
+        OperandEncoding::REG>(),
+    // 10: (iT, int, iReg)
+    makeEncoding<
+        OperandEncoding::NONE,
+        OperandEncoding::I64,
+        OperandEncoding::REG>(),
+    // 11: (iT, RO, iReg)
+    makeEncoding<
+        OperandEncoding::TYPE,
+        OperandEncoding::REG_OFFSET,
+        OperandEncoding::REG>(),
+    // 12: (fT, float, fReg)
+    makeEncoding<
+        OperandEncoding::NONE,
+        OperandEncoding::F32,
+        OperandEncoding::REG>(),
+    // 13: (fT, float, fReg)
+    makeEncoding<
+        OperandEncoding::NONE,
+        OperandEncoding::F64,
+        OperandEncoding::REG>(),
+    // 14: (fT, RO, fReg)
+    makeEncoding<
+        OperandEncoding::TYPE,
+        OperandEncoding::REG_OFFSET,
+        OperandEncoding::REG>(),
+    // 15: (iT, iReg, RO)
+    makeEncoding<
+        OperandEncoding::TYPE,
+        OperandEncoding::REG,
+        OperandEncoding::REG_OFFSET>(),
+    // 16: (fT, fReg, RO)
+    makeEncoding<
+        OperandEncoding::TYPE,
+        OperandEncoding::REG,
+        OperandEncoding::REG_OFFSET>(),
+    // 17: (iT, int, RO)
+    makeEncoding<
+        OperandEncoding::NONE,
+        OperandEncoding::I8,
+        OperandEncoding::REG_OFFSET>(),
+    // 18: (iT, int, RO)
+    makeEncoding<
+        OperandEncoding::NONE,
+        OperandEncoding::I16,
+        OperandEncoding::REG_OFFSET>(),
+    // 19: (iT, int, RO)
+    makeEncoding<
+        OperandEncoding::NONE,
+        OperandEncoding::I32,
+        OperandEncoding::REG_OFFSET>(),
+    // 20: (iT, int, RO)
+    makeEncoding<
+        OperandEncoding::NONE,
+        OperandEncoding::I64,
+        OperandEncoding::REG_OFFSET>(),
+    // 21: (iT, iReg, iReg)
+    makeEncoding<
+        OperandEncoding::TYPE,
+        OperandEncoding::REG,
+        OperandEncoding::REG>(),
+    // 22: (iT, RO, RO)
+    makeEncoding<
+        OperandEncoding::TYPE,
+        OperandEncoding::REG_OFFSET,
+        OperandEncoding::REG_OFFSET>(),
+    // 23: (fT, float, RO)
+    makeEncoding<
+        OperandEncoding::NONE,
+        OperandEncoding::F32,
+        OperandEncoding::REG_OFFSET>(),
+    // 24: (fT, float, RO)
+    makeEncoding<
+        OperandEncoding::NONE,
+        OperandEncoding::F64,
+        OperandEncoding::REG_OFFSET>(),
+    // 25: (fT, fReg, fReg)
+    makeEncoding<
+        OperandEncoding::TYPE,
+        OperandEncoding::REG,
+        OperandEncoding::REG>(),
+    // 26: (fT, RO, RO)
+    makeEncoding<
+        OperandEncoding::TYPE,
+        OperandEncoding::REG_OFFSET,
+        OperandEncoding::REG_OFFSET>(),
+    // 27: (label)
+    makeEncoding<
+        OperandEncoding::LABEL>(),
+    // 28: (sysID)
+    makeEncoding<
+        OperandEncoding::I8>(),
+    // 29: (RO, iReg)
+    makeEncoding<
+        OperandEncoding::REG_OFFSET,
+        OperandEncoding::REG>(),
+    // 30: (iT, iReg, int)
+    makeEncoding<
+        OperandEncoding::NONE,
+        OperandEncoding::REG,
+        OperandEncoding::I8>(),
+    // 31: (iT, iReg, int)
+    makeEncoding<
+        OperandEncoding::NONE,
+        OperandEncoding::REG,
+        OperandEncoding::I16>(),
+    // 32: (iT, iReg, int)
+    makeEncoding<
+        OperandEncoding::NONE,
+        OperandEncoding::REG,
+        OperandEncoding::I32>(),
+    // 33: (iT, iReg, int)
+    makeEncoding<
+        OperandEncoding::NONE,
+        OperandEncoding::REG,
+        OperandEncoding::I64>(),
+    // 34: (fT, fReg, float)
+    makeEncoding<
+        OperandEncoding::NONE,
+        OperandEncoding::REG,
+        OperandEncoding::F32>(),
+    // 35: (fT, fReg, float)
+    makeEncoding<
+        OperandEncoding::NONE,
+        OperandEncoding::REG,
+        OperandEncoding::F64>(),
+    // 36: (fT, fReg)
+    makeEncoding<
+        OperandEncoding::TYPE,
+        OperandEncoding::REG>(),
+    // 37: (iReg, iReg)
+    makeEncoding<
+        OperandEncoding::REG,
+        OperandEncoding::REG>(),
+    // 38: (iReg)
+    makeEncoding<
+        OperandEncoding::REG>(),
+    // 39: (fReg)
+    makeEncoding<
+        OperandEncoding::REG>(),
+    // 40: (iReg, fReg)
+    makeEncoding<
+        OperandEncoding::REG,
+        OperandEncoding::REG>(),
+    // 41: (fReg, iReg)
+    makeEncoding<
+        OperandEncoding::REG,
+        OperandEncoding::REG>(),
+}};
+
+// Index of the first param list of every instruction followed by the
+// total amount of param lists
+constexpr std::array<uint16_t, 55> INSTR_PARAM_LIST_INDEX{
+    0, 1, 3, 5, 7, 9, 10, 11, 14, 17, 18, 19,
+    20, 21, 22, 24, 26, 28, 30, 32, 34, 36, 38, 40,
+    42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53,
+    54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65,
+    66, 67, 68, 69, 70, 71, 72,
 };
 
-const std::array<std::vector<InstrParamList>, 54> INSTR_ASM_DEFS{
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0xA0,
-            0,
-            {},
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x01,
-            INSTR_FLAG_TYPE_VARIANTS,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_NUM,
-            },
-            {
-                {UVM_TYPE_I8, 0x01},
-                {UVM_TYPE_I16, 0x02},
-                {UVM_TYPE_I32, 0x03},
-                {UVM_TYPE_I64, 0x04},
-            },
-        },
-        InstrParamList{
-            0x05,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x06,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::INT_TYPE,
-            },
-            {},
-        },
-        InstrParamList{
-            0x07,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x11,
-            INSTR_FLAG_TYPE_VARIANTS,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_NUM,
-                InstrParamType::INT_REG,
-            },
-            {
-                {UVM_TYPE_I8, 0x11},
-                {UVM_TYPE_I16, 0x12},
-                {UVM_TYPE_I32, 0x13},
-                {UVM_TYPE_I64, 0x14},
-            },
-        },
-        InstrParamList{
-            0x15,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::REG_OFFSET,
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x16,
-            INSTR_FLAG_TYPE_VARIANTS,
-            {
-                InstrParamType::FLOAT_TYPE,
-                InstrParamType::FLOAT_NUM,
-                InstrParamType::FLOAT_REG,
-            },
-            {
-                {UVM_TYPE_F32, 0x16},
-                {UVM_TYPE_F64, 0x17},
-            },
-        },
-        InstrParamList{
-            0x18,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::FLOAT_TYPE,
-                InstrParamType::REG_OFFSET,
-                InstrParamType::FLOAT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x08,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_REG,
-                InstrParamType::REG_OFFSET,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x09,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::FLOAT_TYPE,
-                InstrParamType::FLOAT_REG,
-                InstrParamType::REG_OFFSET,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x21,
-            INSTR_FLAG_TYPE_VARIANTS,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_NUM,
-                InstrParamType::REG_OFFSET,
-            },
-            {
-                {UVM_TYPE_I8, 0x21},
-                {UVM_TYPE_I16, 0x22},
-                {UVM_TYPE_I32, 0x23},
-                {UVM_TYPE_I64, 0x24},
-            },
-        },
-        InstrParamList{
-            0x25,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_REG,
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-        InstrParamList{
-            0x26,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::REG_OFFSET,
-                InstrParamType::REG_OFFSET,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x27,
-            INSTR_FLAG_TYPE_VARIANTS,
-            {
-                InstrParamType::FLOAT_TYPE,
-                InstrParamType::FLOAT_NUM,
-                InstrParamType::REG_OFFSET,
-            },
-            {
-                {UVM_TYPE_F32, 0x27},
-                {UVM_TYPE_F64, 0x28},
-            },
-        },
-        InstrParamList{
-            0x29,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::FLOAT_TYPE,
-                InstrParamType::FLOAT_REG,
-                InstrParamType::FLOAT_REG,
-            },
-            {},
-        },
-        InstrParamList{
-            0x2A,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::FLOAT_TYPE,
-                InstrParamType::REG_OFFSET,
-                InstrParamType::REG_OFFSET,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x50,
-            0,
-            {},
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x20,
-            0,
-            {
-                InstrParamType::LABEL_ID,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x30,
-            0,
-            {},
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x40,
-            0,
-            {
-                InstrParamType::SYS_INT,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x10,
-            0,
-            {
-                InstrParamType::REG_OFFSET,
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x31,
-            INSTR_FLAG_TYPE_VARIANTS,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_REG,
-                InstrParamType::INT_NUM,
-            },
-            {
-                {UVM_TYPE_I8, 0x31},
-                {UVM_TYPE_I16, 0x32},
-                {UVM_TYPE_I32, 0x33},
-                {UVM_TYPE_I64, 0x34},
-            },
-        },
-        InstrParamList{
-            0x35,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_REG,
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x36,
-            INSTR_FLAG_TYPE_VARIANTS,
-            {
-                InstrParamType::FLOAT_TYPE,
-                InstrParamType::FLOAT_REG,
-                InstrParamType::FLOAT_NUM,
-            },
-            {
-                {UVM_TYPE_F32, 0x36},
-                {UVM_TYPE_F64, 0x37},
-            },
-        },
-        InstrParamList{
-            0x38,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::FLOAT_TYPE,
-                InstrParamType::FLOAT_REG,
-                InstrParamType::FLOAT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x41,
-            INSTR_FLAG_TYPE_VARIANTS,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_REG,
-                InstrParamType::INT_NUM,
-            },
-            {
-                {UVM_TYPE_I8, 0x41},
-                {UVM_TYPE_I16, 0x42},
-                {UVM_TYPE_I32, 0x43},
-                {UVM_TYPE_I64, 0x44},
-            },
-        },
-        InstrParamList{
-            0x45,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_REG,
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x46,
-            INSTR_FLAG_TYPE_VARIANTS,
-            {
-                InstrParamType::FLOAT_TYPE,
-                InstrParamType::FLOAT_REG,
-                InstrParamType::FLOAT_NUM,
-            },
-            {
-                {UVM_TYPE_F32, 0x46},
-                {UVM_TYPE_F64, 0x47},
-            },
-        },
-        InstrParamList{
-            0x48,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::FLOAT_TYPE,
-                InstrParamType::FLOAT_REG,
-                InstrParamType::FLOAT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x51,
-            INSTR_FLAG_TYPE_VARIANTS,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_REG,
-                InstrParamType::INT_NUM,
-            },
-            {
-                {UVM_TYPE_I8, 0x51},
-                {UVM_TYPE_I16, 0x52},
-                {UVM_TYPE_I32, 0x53},
-                {UVM_TYPE_I64, 0x54},
-            },
-        },
-        InstrParamList{
-            0x55,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_REG,
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x56,
-            INSTR_FLAG_TYPE_VARIANTS,
-            {
-                InstrParamType::FLOAT_TYPE,
-                InstrParamType::FLOAT_REG,
-                InstrParamType::FLOAT_NUM,
-            },
-            {
-                {UVM_TYPE_F32, 0x56},
-                {UVM_TYPE_F64, 0x57},
-            },
-        },
-        InstrParamList{
-            0x58,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::FLOAT_TYPE,
-                InstrParamType::FLOAT_REG,
-                InstrParamType::FLOAT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x59,
-            INSTR_FLAG_TYPE_VARIANTS,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_REG,
-                InstrParamType::INT_NUM,
-            },
-            {
-                {UVM_TYPE_I8, 0x59},
-                {UVM_TYPE_I16, 0x5A},
-                {UVM_TYPE_I32, 0x5B},
-                {UVM_TYPE_I64, 0x5C},
-            },
-        },
-        InstrParamList{
-            0x5D,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_REG,
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x61,
-            INSTR_FLAG_TYPE_VARIANTS,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_REG,
-                InstrParamType::INT_NUM,
-            },
-            {
-                {UVM_TYPE_I8, 0x61},
-                {UVM_TYPE_I16, 0x62},
-                {UVM_TYPE_I32, 0x63},
-                {UVM_TYPE_I64, 0x64},
-            },
-        },
-        InstrParamList{
-            0x65,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_REG,
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x66,
-            INSTR_FLAG_TYPE_VARIANTS,
-            {
-                InstrParamType::FLOAT_TYPE,
-                InstrParamType::FLOAT_REG,
-                InstrParamType::FLOAT_NUM,
-            },
-            {
-                {UVM_TYPE_F32, 0x66},
-                {UVM_TYPE_F64, 0x67},
-            },
-        },
-        InstrParamList{
-            0x68,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::FLOAT_TYPE,
-                InstrParamType::FLOAT_REG,
-                InstrParamType::FLOAT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x69,
-            INSTR_FLAG_TYPE_VARIANTS,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_REG,
-                InstrParamType::INT_NUM,
-            },
-            {
-                {UVM_TYPE_I8, 0x69},
-                {UVM_TYPE_I16, 0x6A},
-                {UVM_TYPE_I32, 0x6B},
-                {UVM_TYPE_I64, 0x6C},
-            },
-        },
-        InstrParamList{
-            0x6D,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_REG,
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x86,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::FLOAT_TYPE,
-                InstrParamType::FLOAT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x96,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_REG,
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x75,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_REG,
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x85,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_REG,
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x95,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_REG,
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0xA5,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x76,
-            0,
-            {
-                InstrParamType::INT_REG,
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x77,
-            0,
-            {
-                InstrParamType::INT_REG,
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0x78,
-            0,
-            {
-                InstrParamType::INT_REG,
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0xB1,
-            0,
-            {
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0xB2,
-            0,
-            {
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0xB3,
-            0,
-            {
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0xC1,
-            0,
-            {
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0xC2,
-            0,
-            {
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0xC3,
-            0,
-            {
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0xB4,
-            0,
-            {
-                InstrParamType::FLOAT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0xC4,
-            0,
-            {
-                InstrParamType::FLOAT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0xB5,
-            0,
-            {
-                InstrParamType::INT_REG,
-                InstrParamType::FLOAT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0xC5,
-            0,
-            {
-                InstrParamType::INT_REG,
-                InstrParamType::FLOAT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0xB6,
-            0,
-            {
-                InstrParamType::FLOAT_REG,
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0xC6,
-            0,
-            {
-                InstrParamType::FLOAT_REG,
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0xD1,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::INT_TYPE,
-                InstrParamType::INT_REG,
-                InstrParamType::INT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0xD5,
-            INSTR_FLAG_ENCODE_TYPE,
-            {
-                InstrParamType::FLOAT_TYPE,
-                InstrParamType::FLOAT_REG,
-                InstrParamType::FLOAT_REG,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0xE1,
-            0,
-            {
-                InstrParamType::LABEL_ID,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0xE2,
-            0,
-            {
-                InstrParamType::LABEL_ID,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0xE3,
-            0,
-            {
-                InstrParamType::LABEL_ID,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0xE4,
-            0,
-            {
-                InstrParamType::LABEL_ID,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0xE5,
-            0,
-            {
-                InstrParamType::LABEL_ID,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0xE6,
-            0,
-            {
-                InstrParamType::LABEL_ID,
-            },
-            {},
-        },
-    },
-    std::vector<InstrParamList>{
-        InstrParamList{
-            0xE7,
-            0,
-            {
-                InstrParamType::LABEL_ID,
-            },
-            {},
+constexpr std::array<InstrParamList, 72> INSTR_PARAM_LISTS{{
+    // nop
+    InstrParamList{
+        0xA0,
+        0,
+        0,
+        0x0,
+        0,
+        {},
+        0,
+        {},
+    },
+    // push
+    InstrParamList{
+        0x01,
+        INSTR_FLAG_TYPE_VARIANTS,
+        1,
+        0x81,
+        2,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_NUM,
+        },
+        4,
+        {
+            {UVM_TYPE_I8, 0x01},
+            {UVM_TYPE_I16, 0x02},
+            {UVM_TYPE_I32, 0x03},
+            {UVM_TYPE_I64, 0x04},
+        },
+    },
+    InstrParamList{
+        0x05,
+        INSTR_FLAG_ENCODE_TYPE,
+        5,
+        0x51,
+        2,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // pop
+    InstrParamList{
+        0x06,
+        INSTR_FLAG_ENCODE_TYPE,
+        6,
+        0x1,
+        1,
+        {
+            InstrParamType::INT_TYPE,
+        },
+        0,
+        {},
+    },
+    InstrParamList{
+        0x07,
+        INSTR_FLAG_ENCODE_TYPE,
+        5,
+        0x51,
+        2,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // load
+    InstrParamList{
+        0x11,
+        INSTR_FLAG_TYPE_VARIANTS,
+        7,
+        0x581,
+        3,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_NUM,
+            InstrParamType::INT_REG,
+        },
+        4,
+        {
+            {UVM_TYPE_I8, 0x11},
+            {UVM_TYPE_I16, 0x12},
+            {UVM_TYPE_I32, 0x13},
+            {UVM_TYPE_I64, 0x14},
+        },
+    },
+    InstrParamList{
+        0x15,
+        INSTR_FLAG_ENCODE_TYPE,
+        11,
+        0x571,
+        3,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::REG_OFFSET,
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // loadf
+    InstrParamList{
+        0x16,
+        INSTR_FLAG_TYPE_VARIANTS,
+        12,
+        0x692,
+        3,
+        {
+            InstrParamType::FLOAT_TYPE,
+            InstrParamType::FLOAT_NUM,
+            InstrParamType::FLOAT_REG,
+        },
+        2,
+        {
+            {UVM_TYPE_F32, 0x16},
+            {UVM_TYPE_F64, 0x17},
+        },
+    },
+    InstrParamList{
+        0x18,
+        INSTR_FLAG_ENCODE_TYPE,
+        14,
+        0x672,
+        3,
+        {
+            InstrParamType::FLOAT_TYPE,
+            InstrParamType::REG_OFFSET,
+            InstrParamType::FLOAT_REG,
+        },
+        0,
+        {},
+    },
+    // store
+    InstrParamList{
+        0x08,
+        INSTR_FLAG_ENCODE_TYPE,
+        15,
+        0x751,
+        3,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_REG,
+            InstrParamType::REG_OFFSET,
+        },
+        0,
+        {},
+    },
+    // storef
+    InstrParamList{
+        0x09,
+        INSTR_FLAG_ENCODE_TYPE,
+        16,
+        0x762,
+        3,
+        {
+            InstrParamType::FLOAT_TYPE,
+            InstrParamType::FLOAT_REG,
+            InstrParamType::REG_OFFSET,
+        },
+        0,
+        {},
+    },
+    // copy
+    InstrParamList{
+        0x21,
+        INSTR_FLAG_TYPE_VARIANTS,
+        17,
+        0x781,
+        3,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_NUM,
+            InstrParamType::REG_OFFSET,
+        },
+        4,
+        {
+            {UVM_TYPE_I8, 0x21},
+            {UVM_TYPE_I16, 0x22},
+            {UVM_TYPE_I32, 0x23},
+            {UVM_TYPE_I64, 0x24},
+        },
+    },
+    InstrParamList{
+        0x25,
+        INSTR_FLAG_ENCODE_TYPE,
+        21,
+        0x551,
+        3,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_REG,
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    InstrParamList{
+        0x26,
+        INSTR_FLAG_ENCODE_TYPE,
+        22,
+        0x771,
+        3,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::REG_OFFSET,
+            InstrParamType::REG_OFFSET,
+        },
+        0,
+        {},
+    },
+    // copyf
+    InstrParamList{
+        0x27,
+        INSTR_FLAG_TYPE_VARIANTS,
+        23,
+        0x792,
+        3,
+        {
+            InstrParamType::FLOAT_TYPE,
+            InstrParamType::FLOAT_NUM,
+            InstrParamType::REG_OFFSET,
+        },
+        2,
+        {
+            {UVM_TYPE_F32, 0x27},
+            {UVM_TYPE_F64, 0x28},
+        },
+    },
+    InstrParamList{
+        0x29,
+        INSTR_FLAG_ENCODE_TYPE,
+        25,
+        0x662,
+        3,
+        {
+            InstrParamType::FLOAT_TYPE,
+            InstrParamType::FLOAT_REG,
+            InstrParamType::FLOAT_REG,
+        },
+        0,
+        {},
+    },
+    InstrParamList{
+        0x2A,
+        INSTR_FLAG_ENCODE_TYPE,
+        26,
+        0x772,
+        3,
+        {
+            InstrParamType::FLOAT_TYPE,
+            InstrParamType::REG_OFFSET,
+            InstrParamType::REG_OFFSET,
+        },
+        0,
+        {},
+    },
+    // exit
+    InstrParamList{
+        0x50,
+        0,
+        0,
+        0x0,
+        0,
+        {},
+        0,
+        {},
+    },
+    // call
+    InstrParamList{
+        0x20,
+        0,
+        27,
+        0x3,
+        1,
+        {
+            InstrParamType::LABEL_ID,
+        },
+        0,
+        {},
+    },
+    // ret
+    InstrParamList{
+        0x30,
+        0,
+        0,
+        0x0,
+        0,
+        {},
+        0,
+        {},
+    },
+    // sys
+    InstrParamList{
+        0x40,
+        0,
+        28,
+        0x8,
+        1,
+        {
+            InstrParamType::SYS_INT,
+        },
+        0,
+        {},
+    },
+    // lea
+    InstrParamList{
+        0x10,
+        0,
+        29,
+        0x57,
+        2,
+        {
+            InstrParamType::REG_OFFSET,
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // add
+    InstrParamList{
+        0x31,
+        INSTR_FLAG_TYPE_VARIANTS,
+        30,
+        0x851,
+        3,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_REG,
+            InstrParamType::INT_NUM,
+        },
+        4,
+        {
+            {UVM_TYPE_I8, 0x31},
+            {UVM_TYPE_I16, 0x32},
+            {UVM_TYPE_I32, 0x33},
+            {UVM_TYPE_I64, 0x34},
+        },
+    },
+    InstrParamList{
+        0x35,
+        INSTR_FLAG_ENCODE_TYPE,
+        21,
+        0x551,
+        3,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_REG,
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // addf
+    InstrParamList{
+        0x36,
+        INSTR_FLAG_TYPE_VARIANTS,
+        34,
+        0x962,
+        3,
+        {
+            InstrParamType::FLOAT_TYPE,
+            InstrParamType::FLOAT_REG,
+            InstrParamType::FLOAT_NUM,
+        },
+        2,
+        {
+            {UVM_TYPE_F32, 0x36},
+            {UVM_TYPE_F64, 0x37},
         },
     },
+    InstrParamList{
+        0x38,
+        INSTR_FLAG_ENCODE_TYPE,
+        25,
+        0x662,
+        3,
+        {
+            InstrParamType::FLOAT_TYPE,
+            InstrParamType::FLOAT_REG,
+            InstrParamType::FLOAT_REG,
+        },
+        0,
+        {},
+    },
+    // sub
+    InstrParamList{
+        0x41,
+        INSTR_FLAG_TYPE_VARIANTS,
+        30,
+        0x851,
+        3,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_REG,
+            InstrParamType::INT_NUM,
+        },
+        4,
+        {
+            {UVM_TYPE_I8, 0x41},
+            {UVM_TYPE_I16, 0x42},
+            {UVM_TYPE_I32, 0x43},
+            {UVM_TYPE_I64, 0x44},
+        },
+    },
+    InstrParamList{
+        0x45,
+        INSTR_FLAG_ENCODE_TYPE,
+        21,
+        0x551,
+        3,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_REG,
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // subf
+    InstrParamList{
+        0x46,
+        INSTR_FLAG_TYPE_VARIANTS,
+        34,
+        0x962,
+        3,
+        {
+            InstrParamType::FLOAT_TYPE,
+            InstrParamType::FLOAT_REG,
+            InstrParamType::FLOAT_NUM,
+        },
+        2,
+        {
+            {UVM_TYPE_F32, 0x46},
+            {UVM_TYPE_F64, 0x47},
+        },
+    },
+    InstrParamList{
+        0x48,
+        INSTR_FLAG_ENCODE_TYPE,
+        25,
+        0x662,
+        3,
+        {
+            InstrParamType::FLOAT_TYPE,
+            InstrParamType::FLOAT_REG,
+            InstrParamType::FLOAT_REG,
+        },
+        0,
+        {},
+    },
+    // mul
+    InstrParamList{
+        0x51,
+        INSTR_FLAG_TYPE_VARIANTS,
+        30,
+        0x851,
+        3,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_REG,
+            InstrParamType::INT_NUM,
+        },
+        4,
+        {
+            {UVM_TYPE_I8, 0x51},
+            {UVM_TYPE_I16, 0x52},
+            {UVM_TYPE_I32, 0x53},
+            {UVM_TYPE_I64, 0x54},
+        },
+    },
+    InstrParamList{
+        0x55,
+        INSTR_FLAG_ENCODE_TYPE,
+        21,
+        0x551,
+        3,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_REG,
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // mulf
+    InstrParamList{
+        0x56,
+        INSTR_FLAG_TYPE_VARIANTS,
+        34,
+        0x962,
+        3,
+        {
+            InstrParamType::FLOAT_TYPE,
+            InstrParamType::FLOAT_REG,
+            InstrParamType::FLOAT_NUM,
+        },
+        2,
+        {
+            {UVM_TYPE_F32, 0x56},
+            {UVM_TYPE_F64, 0x57},
+        },
+    },
+    InstrParamList{
+        0x58,
+        INSTR_FLAG_ENCODE_TYPE,
+        25,
+        0x662,
+        3,
+        {
+            InstrParamType::FLOAT_TYPE,
+            InstrParamType::FLOAT_REG,
+            InstrParamType::FLOAT_REG,
+        },
+        0,
+        {},
+    },
+    // muls
+    InstrParamList{
+        0x59,
+        INSTR_FLAG_TYPE_VARIANTS,
+        30,
+        0x851,
+        3,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_REG,
+            InstrParamType::INT_NUM,
+        },
+        4,
+        {
+            {UVM_TYPE_I8, 0x59},
+            {UVM_TYPE_I16, 0x5A},
+            {UVM_TYPE_I32, 0x5B},
+            {UVM_TYPE_I64, 0x5C},
+        },
+    },
+    InstrParamList{
+        0x5D,
+        INSTR_FLAG_ENCODE_TYPE,
+        21,
+        0x551,
+        3,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_REG,
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // div
+    InstrParamList{
+        0x61,
+        INSTR_FLAG_TYPE_VARIANTS,
+        30,
+        0x851,
+        3,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_REG,
+            InstrParamType::INT_NUM,
+        },
+        4,
+        {
+            {UVM_TYPE_I8, 0x61},
+            {UVM_TYPE_I16, 0x62},
+            {UVM_TYPE_I32, 0x63},
+            {UVM_TYPE_I64, 0x64},
+        },
+    },
+    InstrParamList{
+        0x65,
+        INSTR_FLAG_ENCODE_TYPE,
+        21,
+        0x551,
+        3,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_REG,
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // divf
+    InstrParamList{
+        0x66,
+        INSTR_FLAG_TYPE_VARIANTS,
+        34,
+        0x962,
+        3,
+        {
+            InstrParamType::FLOAT_TYPE,
+            InstrParamType::FLOAT_REG,
+            InstrParamType::FLOAT_NUM,
+        },
+        2,
+        {
+            {UVM_TYPE_F32, 0x66},
+            {UVM_TYPE_F64, 0x67},
+        },
+    },
+    InstrParamList{
+        0x68,
+        INSTR_FLAG_ENCODE_TYPE,
+        25,
+        0x662,
+        3,
+        {
+            InstrParamType::FLOAT_TYPE,
+            InstrParamType::FLOAT_REG,
+            InstrParamType::FLOAT_REG,
+        },
+        0,
+        {},
+    },
+    // divs
+    InstrParamList{
+        0x69,
+        INSTR_FLAG_TYPE_VARIANTS,
+        30,
+        0x851,
+        3,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_REG,
+            InstrParamType::INT_NUM,
+        },
+        4,
+        {
+            {UVM_TYPE_I8, 0x69},
+            {UVM_TYPE_I16, 0x6A},
+            {UVM_TYPE_I32, 0x6B},
+            {UVM_TYPE_I64, 0x6C},
+        },
+    },
+    InstrParamList{
+        0x6D,
+        INSTR_FLAG_ENCODE_TYPE,
+        21,
+        0x551,
+        3,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_REG,
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // sqrt
+    InstrParamList{
+        0x86,
+        INSTR_FLAG_ENCODE_TYPE,
+        36,
+        0x62,
+        2,
+        {
+            InstrParamType::FLOAT_TYPE,
+            InstrParamType::FLOAT_REG,
+        },
+        0,
+        {},
+    },
+    // mod
+    InstrParamList{
+        0x96,
+        INSTR_FLAG_ENCODE_TYPE,
+        21,
+        0x551,
+        3,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_REG,
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // and
+    InstrParamList{
+        0x75,
+        INSTR_FLAG_ENCODE_TYPE,
+        21,
+        0x551,
+        3,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_REG,
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // or
+    InstrParamList{
+        0x85,
+        INSTR_FLAG_ENCODE_TYPE,
+        21,
+        0x551,
+        3,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_REG,
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // xor
+    InstrParamList{
+        0x95,
+        INSTR_FLAG_ENCODE_TYPE,
+        21,
+        0x551,
+        3,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_REG,
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // not
+    InstrParamList{
+        0xA5,
+        INSTR_FLAG_ENCODE_TYPE,
+        5,
+        0x51,
+        2,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // lsh
+    InstrParamList{
+        0x76,
+        0,
+        37,
+        0x55,
+        2,
+        {
+            InstrParamType::INT_REG,
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // rsh
+    InstrParamList{
+        0x77,
+        0,
+        37,
+        0x55,
+        2,
+        {
+            InstrParamType::INT_REG,
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // srsh
+    InstrParamList{
+        0x78,
+        0,
+        37,
+        0x55,
+        2,
+        {
+            InstrParamType::INT_REG,
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // b2l
+    InstrParamList{
+        0xB1,
+        0,
+        38,
+        0x5,
+        1,
+        {
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // s2l
+    InstrParamList{
+        0xB2,
+        0,
+        38,
+        0x5,
+        1,
+        {
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // i2l
+    InstrParamList{
+        0xB3,
+        0,
+        38,
+        0x5,
+        1,
+        {
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // b2sl
+    InstrParamList{
+        0xC1,
+        0,
+        38,
+        0x5,
+        1,
+        {
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // s2sl
+    InstrParamList{
+        0xC2,
+        0,
+        38,
+        0x5,
+        1,
+        {
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // i2sl
+    InstrParamList{
+        0xC3,
+        0,
+        38,
+        0x5,
+        1,
+        {
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // f2d
+    InstrParamList{
+        0xB4,
+        0,
+        39,
+        0x6,
+        1,
+        {
+            InstrParamType::FLOAT_REG,
+        },
+        0,
+        {},
+    },
+    // d2f
+    InstrParamList{
+        0xC4,
+        0,
+        39,
+        0x6,
+        1,
+        {
+            InstrParamType::FLOAT_REG,
+        },
+        0,
+        {},
+    },
+    // i2f
+    InstrParamList{
+        0xB5,
+        0,
+        40,
+        0x65,
+        2,
+        {
+            InstrParamType::INT_REG,
+            InstrParamType::FLOAT_REG,
+        },
+        0,
+        {},
+    },
+    // i2d
+    InstrParamList{
+        0xC5,
+        0,
+        40,
+        0x65,
+        2,
+        {
+            InstrParamType::INT_REG,
+            InstrParamType::FLOAT_REG,
+        },
+        0,
+        {},
+    },
+    // f2i
+    InstrParamList{
+        0xB6,
+        0,
+        41,
+        0x56,
+        2,
+        {
+            InstrParamType::FLOAT_REG,
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // d2i
+    InstrParamList{
+        0xC6,
+        0,
+        41,
+        0x56,
+        2,
+        {
+            InstrParamType::FLOAT_REG,
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // cmp
+    InstrParamList{
+        0xD1,
+        INSTR_FLAG_ENCODE_TYPE,
+        21,
+        0x551,
+        3,
+        {
+            InstrParamType::INT_TYPE,
+            InstrParamType::INT_REG,
+            InstrParamType::INT_REG,
+        },
+        0,
+        {},
+    },
+    // cmpf
+    InstrParamList{
+        0xD5,
+        INSTR_FLAG_ENCODE_TYPE,
+        25,
+        0x662,
+        3,
+        {
+            InstrParamType::FLOAT_TYPE,
+            InstrParamType::FLOAT_REG,
+            InstrParamType::FLOAT_REG,
+        },
+        0,
+        {},
+    },
+    // jmp
+    InstrParamList{
+        0xE1,
+        0,
+        27,
+        0x3,
+        1,
+        {
+            InstrParamType::LABEL_ID,
+        },
+        0,
+        {},
+    },
+    // je
+    InstrParamList{
+        0xE2,
+        0,
+        27,
+        0x3,
+        1,
+        {
+            InstrParamType::LABEL_ID,
+        },
+        0,
+        {},
+    },
+    // jne
+    InstrParamList{
+        0xE3,
+        0,
+        27,
+        0x3,
+        1,
+        {
+            InstrParamType::LABEL_ID,
+        },
+        0,
+        {},
+    },
+    // jgt
+    InstrParamList{
+        0xE4,
+        0,
+        27,
+        0x3,
+        1,
+        {
+            InstrParamType::LABEL_ID,
+        },
+        0,
+        {},
+    },
+    // jlt
+    InstrParamList{
+        0xE5,
+        0,
+        27,
+        0x3,
+        1,
+        {
+            InstrParamType::LABEL_ID,
+        },
+        0,
+        {},
+    },
+    // jge
+    InstrParamList{
+        0xE6,
+        0,
+        27,
+        0x3,
+        1,
+        {
+            InstrParamType::LABEL_ID,
+        },
+        0,
+        {},
+    },
+    // jle
+    InstrParamList{
+        0xE7,
+        0,
+        27,
+        0x3,
+        1,
+        {
+            InstrParamType::LABEL_ID,
+        },
+        0,
+        {},
+    },
+}};
+
+// Perfect hash table of every keyword (instruction names, type names and
+// register names). See findKeyword() in asm.cpp for how a slot is found
+constexpr uint32_t KEYWORD_HASH_SEED = 2;
+constexpr uint32_t KEYWORD_MAX_SIZE = 6;
+constexpr uint32_t KEYWORD_TABLE_SIZE = 128;
+constexpr uint32_t KEYWORD_BUCKET_COUNT = 64;
+
+constexpr std::array<uint8_t, KEYWORD_BUCKET_COUNT> KEYWORD_DISPLACEMENTS{
+    24, 10, 0, 0, 0, 5, 6, 0, 13, 2, 0, 0, 12, 0, 4, 0,
+    1, 0, 0, 23, 24, 24, 5, 0, 13, 4, 4, 32, 9, 1, 1, 29,
+    3, 1, 0, 0, 17, 7, 2, 0, 0, 14, 0, 18, 18, 0, 2, 0,
+    1, 13, 8, 17, 0, 31, 0, 24, 15, 38, 6, 33, 1, 0, 0, 21,
 };
 
+constexpr std::array<KeywordEntry, KEYWORD_TABLE_SIZE> KEYWORD_TABLE{{
+    {"f1", 2, TokenType::REGISTER_DEFINITION, 0x17},
+    {"div", 3, TokenType::INSTRUCTION, 21},
+    {"f0", 2, TokenType::REGISTER_DEFINITION, 0x16},
+    {"f5", 2, TokenType::REGISTER_DEFINITION, 0x1B},
+    {"lsh", 3, TokenType::INSTRUCTION, 30},
+    {"ip", 2, TokenType::REGISTER_DEFINITION, 0x1},
+    {"i8", 2, TokenType::TYPE_INFO, UVM_TYPE_I8},
+    {"je", 2, TokenType::INSTRUCTION, 48},
+    {"d2f", 3, TokenType::INSTRUCTION, 40},
+    {"f9", 2, TokenType::REGISTER_DEFINITION, 0x1F},
+    {"xor", 3, TokenType::INSTRUCTION, 28},
+    {"jgt", 3, TokenType::INSTRUCTION, 50},
+    {"i2sl", 4, TokenType::INSTRUCTION, 38},
+    {"f3", 2, TokenType::REGISTER_DEFINITION, 0x19},
+    {"f6", 2, TokenType::REGISTER_DEFINITION, 0x1C},
+    {"d2i", 3, TokenType::INSTRUCTION, 44},
+    {"jge", 3, TokenType::INSTRUCTION, 52},
+    {"f7", 2, TokenType::REGISTER_DEFINITION, 0x1D},
+    {"load", 4, TokenType::INSTRUCTION, 3},
+    {},
+    {"or", 2, TokenType::INSTRUCTION, 27},
+    {},
+    {"r15", 3, TokenType::REGISTER_DEFINITION, 0x14},
+    {"b2sl", 4, TokenType::INSTRUCTION, 36},
+    {"r12", 3, TokenType::REGISTER_DEFINITION, 0x11},
+    {"ret", 3, TokenType::INSTRUCTION, 11},
+    {"r8", 2, TokenType::REGISTER_DEFINITION, 0xD},
+    {"r9", 2, TokenType::REGISTER_DEFINITION, 0xE},
+    {"r4", 2, TokenType::REGISTER_DEFINITION, 0x9},
+    {"str", 3, TokenType::TYPE_INFO, BASS_TYPE_STRING},
+    {"jle", 3, TokenType::INSTRUCTION, 53},
+    {"r1", 2, TokenType::REGISTER_DEFINITION, 0x6},
+    {"r13", 3, TokenType::REGISTER_DEFINITION, 0x12},
+    {"divs", 4, TokenType::INSTRUCTION, 23},
+    {"r0", 2, TokenType::REGISTER_DEFINITION, 0x5},
+    {"r10", 3, TokenType::REGISTER_DEFINITION, 0xF},
+    {"cmp", 3, TokenType::INSTRUCTION, 45},
+    {"f64", 3, TokenType::TYPE_INFO, UVM_TYPE_F64},
+    {"r2", 2, TokenType::REGISTER_DEFINITION, 0x7},
+    {"f12", 3, TokenType::REGISTER_DEFINITION, 0x22},
+    {"f13", 3, TokenType::REGISTER_DEFINITION, 0x23},
+    {"sub", 3, TokenType::INSTRUCTION, 16},
+    {"loadf", 5, TokenType::INSTRUCTION, 4},
+    {"jlt", 3, TokenType::INSTRUCTION, 51},
+    {"jmp", 3, TokenType::INSTRUCTION, 47},
+    {"f32", 3, TokenType::TYPE_INFO, UVM_TYPE_F32},
+    {"r14", 3, TokenType::REGISTER_DEFINITION, 0x13},
+    {"f2d", 3, TokenType::INSTRUCTION, 39},
+    {"jne", 3, TokenType::INSTRUCTION, 49},
+    {"r7", 2, TokenType::REGISTER_DEFINITION, 0xC},
+    {"r6", 2, TokenType::REGISTER_DEFINITION, 0xB},
+    {"divf", 4, TokenType::INSTRUCTION, 22},
+    {"f14", 3, TokenType::REGISTER_DEFINITION, 0x24},
+    {"copy", 4, TokenType::INSTRUCTION, 7},
+    {"r11", 3, TokenType::REGISTER_DEFINITION, 0x10},
+    {"r3", 2, TokenType::REGISTER_DEFINITION, 0x8},
+    {"f10", 3, TokenType::REGISTER_DEFINITION, 0x20},
+    {"f15", 3, TokenType::REGISTER_DEFINITION, 0x25},
+    {"lea", 3, TokenType::INSTRUCTION, 13},
+    {"rsh", 3, TokenType::INSTRUCTION, 31},
+    {"nop", 3, TokenType::INSTRUCTION, 0},
+    {"sys", 3, TokenType::INSTRUCTION, 12},
+    {"sp", 2, TokenType::REGISTER_DEFINITION, 0x2},
+    {"f11", 3, TokenType::REGISTER_DEFINITION, 0x21},
+    {"r5", 2, TokenType::REGISTER_DEFINITION, 0xA},
+    {"copyf", 5, TokenType::INSTRUCTION, 8},
+    {"not", 3, TokenType::INSTRUCTION, 29},
+    {"s2l", 3, TokenType::INSTRUCTION, 34},
+    {"i16", 3, TokenType::TYPE_INFO, UVM_TYPE_I16},
+    {"subf", 4, TokenType::INSTRUCTION, 17},
+    {"addf", 4, TokenType::INSTRUCTION, 15},
+    {"f2i", 3, TokenType::INSTRUCTION, 43},
+    {"push", 4, TokenType::INSTRUCTION, 1},
+    {"i2d", 3, TokenType::INSTRUCTION, 42},
+    {"exit", 4, TokenType::INSTRUCTION, 9},
+    {"i2l", 3, TokenType::INSTRUCTION, 35},
+    {"cmpf", 4, TokenType::INSTRUCTION, 46},
+    {"i32", 3, TokenType::TYPE_INFO, UVM_TYPE_I32},
+    {},
+    {"call", 4, TokenType::INSTRUCTION, 10},
+    {},
+    {"store", 5, TokenType::INSTRUCTION, 5},
+    {"mod", 3, TokenType::INSTRUCTION, 25},
+    {"storef", 6, TokenType::INSTRUCTION, 6},
+    {"i2f", 3, TokenType::INSTRUCTION, 41},
+    {"i64", 3, TokenType::TYPE_INFO, UVM_TYPE_I64},
+    {},
+    {},
+    {},
+    {},
+    {},
+    {},
+    {},
+    {},
+    {"mulf", 4, TokenType::INSTRUCTION, 19},
+    {"srsh", 4, TokenType::INSTRUCTION, 32},
+    {},
+    {},
+    {"mul", 3, TokenType::INSTRUCTION, 18},
+    {"b2l", 3, TokenType::INSTRUCTION, 33},
+    {"muls", 4, TokenType::INSTRUCTION, 20},
+    {},
+    {},
+    {},
+    {},
+    {},
+    {},
+    {},
+    {"add", 3, TokenType::INSTRUCTION, 14},
+    {},
+    {},
+    {},
+    {"s2sl", 4, TokenType::INSTRUCTION, 37},
+    {},
+    {"bp", 2, TokenType::REGISTER_DEFINITION, 0x3},
+    {},
+    {},
+    {"and", 3, TokenType::INSTRUCTION, 26},
+    {},
+    {},
+    {},
+    {"sqrt", 4, TokenType::INSTRUCTION, 24},
+    {},
+    {},
+    {"f4", 2, TokenType::REGISTER_DEFINITION, 0x1A},
+    {"f8", 2, TokenType::REGISTER_DEFINITION, 0x1E},
+    {"pop", 3, TokenType::INSTRUCTION, 2},
+    {"f2", 2, TokenType::REGISTER_DEFINITION, 0x18},
+}};
+
 } // namespace Asm
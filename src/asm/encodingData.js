@@ -42,12 +42,11 @@ const HEADER =
 // ======================================================================== //
 
 #pragma once
+#include "../encoder.hpp"
+#include "../token.hpp"
 #include "asm.hpp"
 #include <array>
 #include <cstdint>
-#include <map>
-#include <string>
-#include <vector>
 
 /*
     THIS FILE IS GENERATED BY THE SCRIPT 'encodingData.js' DO NOT MODIFY!
@@ -62,6 +61,18 @@ const UVM_TYPES = {
     'f64': 'UVM_TYPE_F64',
 };
 
+// Type names which can be used in the source code. These are the UVM types and
+// the additional BASS types
+const KEYWORD_TYPES = {
+    ...UVM_TYPES,
+    'str': 'BASS_TYPE_STRING',
+};
+
+// Keyword hash table parameters. KEYWORD_TABLE_SIZE and KEYWORD_BUCKET_COUNT
+// must be powers of two
+const KEYWORD_TABLE_SIZE = 128;
+const KEYWORD_BUCKET_COUNT = 64;
+
 const PARAM_TYPES = {
     'iT': 'INT_TYPE',
     'fT': 'FLOAT_TYPE',
@@ -75,6 +86,39 @@ const PARAM_TYPES = {
     'sysID': 'SYS_INT',
 };
 
+// Operand kind which every param type accepts. This must match OperandKind and
+// getParamKind() in asm.hpp
+const PARAM_KINDS = {
+    'iT': 1,
+    'fT': 2,
+    'label': 3,
+    'function': 4,
+    'iReg': 5,
+    'fReg': 6,
+    'RO': 7,
+    'int': 8,
+    'float': 9,
+    'sysID': 8,
+};
+const SIGNATURE_KIND_BITS = 4;
+
+// Operand encodings of every param type. Immediates have one encoding per data
+// type in the order of the data types, see getInstrEncoder() in parser.cpp
+const PARAM_ENCODINGS = {
+    'iReg': ['REG'],
+    'fReg': ['REG'],
+    'function': ['LABEL'],
+    'label': ['LABEL'],
+    'RO': ['REG_OFFSET'],
+    'int': ['I8', 'I16', 'I32', 'I64'],
+    'float': ['F32', 'F64'],
+    'sysID': ['I8'],
+};
+
+// Size limits of InstrParamList in asm.hpp
+const MAX_INSTR_PARAMS = 3;
+const MAX_TYPE_VARIANTS = 4;
+
 /**
  * Converts JSON format param type to C++ param type
  * @param {string} param
@@ -104,90 +148,311 @@ function tab(count) {
 }
 
 /**
- * Generates the register lookup table
- * @param {*} data JSON Data
- * @return {string} generated C++ code
+ * Packs the operand kinds of a param list into a signature. This must produce
+ * the same result as packOperandKind() in asm.hpp
+ * @param {Array} params JSON format param types
+ * @return {number} Packed signature
  */
-function generateRegisterLookupTable(data) {
-    let buffer = 'const std::map<std::string, uint8_t> ASM_REGISTERS {\n';
-
-    data.registers.forEach((reg) => {
-        buffer += `${tab(1)}{"${reg.name}", ${reg.bytecode}},\n`;
+function packSignature(params) {
+    let signature = 0;
+    params.forEach((param, i) => {
+        signature |= PARAM_KINDS[param] << (i * SIGNATURE_KIND_BITS);
     });
+    return signature >>> 0;
+}
 
-    buffer += '};\n\n';
+/**
+ * Generates the encoding flags of a param list
+ * @param {*} paramList JSON param list
+ * @return {string} generated C++ code
+ */
+function generateParamListFlags(paramList) {
+    if (paramList.encodeType && paramList.typeVariants.length > 0) {
+        return 'INSTR_FLAG_ENCODE_TYPE | INSTR_FLAG_TYPE_VARIANTS';
+    } else if (paramList.encodeType) {
+        return 'INSTR_FLAG_ENCODE_TYPE';
+    } else if (paramList.typeVariants.length > 0) {
+        return 'INSTR_FLAG_TYPE_VARIANTS';
+    }
+    return '0';
+}
 
-    return buffer;
+/**
+ * Returns the operand encodings of a param type
+ * @param {string} param JSON format param type
+ * @param {boolean} encodeType If type infos are encoded
+ * @return {Array} Operand encodings
+ */
+function getParamEncodings(param, encodeType) {
+    if (param === 'iT' || param === 'fT') {
+        return [encodeType ? 'TYPE' : 'NONE'];
+    }
+    return PARAM_ENCODINGS[param];
 }
 
 /**
- *
- * @param {*} data JSON data from file
+ * Collects the distinct instruction forms and assigns every param list the
+ * index of the first encoder of its form. A form with an immediate has one
+ * encoder per immediate width which follow each other
+ * @param {*} data JSON data
+ * @return {Array} Encoders, each a list of operand encodings
  */
-function generateHeaderFile(data) {
-    // Create new output buffer and insert .hpp header
-    let buffer = `${HEADER}\n`;
+function collectEncoders(data) {
+    const forms = new Map();
+    const encoders = [];
+    data.instructions.forEach((instr) => {
+        instr.paramList.forEach((paramList) => {
+            const key = `${paramList.params.join(',')}:${paramList.encodeType}`;
+            if (!forms.has(key)) {
+                forms.set(key, encoders.length);
 
-    buffer += generateRegisterLookupTable(data);
+                let variants = [[]];
+                paramList.params.forEach((param) => {
+                    const encodings = getParamEncodings(param, paramList.encodeType);
+                    if (encodings.length > 1 && variants.length > 1) {
+                        throw new Error(`Param list of '${instr.name}' has more than one immediate`);
+                    }
+                    variants = variants.flatMap((variant) =>
+                        encodings.map((encoding) => [...variant, encoding]));
+                });
+                variants.forEach((variant) => {
+                    encoders.push({ params: paramList.params, encodings: variant });
+                });
+            }
+            paramList.encoder = forms.get(key);
+        });
+    });
+    return encoders;
+}
 
-    // Add namespace
-    buffer += 'namespace Asm {\n';
+/**
+ * Generates the encoder table of all instruction forms
+ * @param {Array} encoders Encoders returned by collectEncoders()
+ * @return {string} generated C++ code
+ */
+function generateEncoderTable(encoders) {
+    let buffer = '// Encoder of every instruction form and immediate width\n';
+    buffer += `constexpr std::array<InstrEncoding, ${encoders.length}> INSTR_ENCODERS{{\n`;
+    encoders.forEach((encoder, i) => {
+        buffer += `${tab(1)}// ${i}: (${encoder.params.join(', ')})\n`;
+        if (encoder.encodings.length === 0) {
+            buffer += `${tab(1)}makeEncoding<>(),\n`;
+            return;
+        }
+        buffer += `${tab(1)}makeEncoding<\n`;
+        const encodings = encoder.encodings.map((encoding) => `${tab(2)}OperandEncoding::${encoding}`);
+        buffer += `${encodings.join(',\n')}>(),\n`;
+    });
+    buffer += '}};\n\n';
+    return buffer;
+}
 
-    // Generate instruction name lookup table
-    buffer += 'const std::map<std::string, uint8_t> INSTR_NAMES {\n';
-    data.instructions.forEach((instr, i) => {
-        buffer += `${tab(1)}{"${instr.name}", ${i}},\n`;
+/**
+ * Generates the param lists of all instructions as a flat table. The param
+ * lists of an instruction are stored next to each other and are found with
+ * the index table
+ * @param {*} data JSON data
+ * @return {string} generated C++ code
+ */
+function generateParamListTable(data) {
+    const index = [];
+    let count = 0;
+    data.instructions.forEach((instr) => {
+        index.push(count);
+        count += instr.paramList.length;
     });
-    // Closing brace of 'constexpr std::map<const char*, uint8_t> INSTR_NAMES {'
-    buffer += '};\n\n';
+    index.push(count);
 
-    // Generate instruction encoding resolution
-    buffer += `const std::array<std::vector<InstrParamList>, ${data.instructions.length}> INSTR_ASM_DEFS {\n`
-    data.instructions.forEach((instr, i) => {
-        buffer += `${tab(1)}std::vector<InstrParamList>{\n`;
+    let buffer = '// Index of the first param list of every instruction followed by the\n';
+    buffer += '// total amount of param lists\n';
+    buffer += `constexpr std::array<uint16_t, ${index.length}> INSTR_PARAM_LIST_INDEX{\n`;
+    for (let i = 0; i < index.length; i += 12) {
+        const row = index.slice(i, i + 12).map((n) => `${n},`);
+        buffer += `${tab(1)}${row.join(' ')}\n`;
+    }
+    buffer += '};\n\n';
 
-        // Instruction paramlist array
+    buffer += `constexpr std::array<InstrParamList, ${count}> INSTR_PARAM_LISTS{{\n`;
+    data.instructions.forEach((instr) => {
+        buffer += `${tab(1)}// ${instr.name}\n`;
         instr.paramList.forEach((paramList) => {
-            buffer += `${tab(2)}InstrParamList{\n`;
-            // Instruction param list content
-            buffer += `${tab(3)}${paramList.opcode},\n`;
-
-            if (paramList.encodeType && paramList.typeVariants.length > 0) {
-                buffer += `${tab(3)}INSTR_FLAG_ENCODE_TYPE | INSTR_FLAG_TYPE_VARIANTS,\n`;
-            } else if (paramList.encodeType) {
-                buffer += `${tab(3)}INSTR_FLAG_ENCODE_TYPE,\n`;
-            } else if (paramList.typeVariants.length > 0) {
-                buffer += `${tab(3)}INSTR_FLAG_TYPE_VARIANTS,\n`;
-            } else {
-                buffer += `${tab(3)}0,\n`;
+            if (paramList.params.length > MAX_INSTR_PARAMS ||
+                paramList.typeVariants.length > MAX_TYPE_VARIANTS) {
+                throw new Error(`Param list of '${instr.name}' exceeds the limits of InstrParamList`);
             }
 
+            buffer += `${tab(1)}InstrParamList{\n`;
+            buffer += `${tab(2)}${paramList.opcode},\n`;
+            buffer += `${tab(2)}${generateParamListFlags(paramList)},\n`;
+            buffer += `${tab(2)}${paramList.encoder},\n`;
+            buffer += `${tab(2)}0x${packSignature(paramList.params).toString(16).toUpperCase()},\n`;
+
             // Instruction params
-            buffer += `${tab(3)}{\n`;
-            paramList.params.forEach((param, i) => {
-                if (i === 0) {
-                    buffer += tab(4);
-                }
-                buffer += `${toCPPParamType(param)}, `;
-                if (i + 1 === paramList.params.length) {
-                    buffer += '\n';
-                }
-            });
-            buffer += `${tab(3)}},\n`;
+            buffer += `${tab(2)}${paramList.params.length},\n`;
+            if (paramList.params.length === 0) {
+                buffer += `${tab(2)}{},\n`;
+            } else {
+                buffer += `${tab(2)}{\n`;
+                paramList.params.forEach((param) => {
+                    buffer += `${tab(3)}${toCPPParamType(param)},\n`;
+                });
+                buffer += `${tab(2)}},\n`;
+            }
 
             // Instruction type variants
-            buffer += `${tab(3)}{\n`;
-            paramList.typeVariants.forEach((variant) => {
-                buffer += `${tab(4)}{${toUVMType(variant.type)}, ${variant.opcode}},\n`;
-            });
-            buffer += `${tab(3)}},\n`;
+            buffer += `${tab(2)}${paramList.typeVariants.length},\n`;
+            if (paramList.typeVariants.length === 0) {
+                buffer += `${tab(2)}{},\n`;
+            } else {
+                buffer += `${tab(2)}{\n`;
+                paramList.typeVariants.forEach((variant) => {
+                    buffer += `${tab(3)}{${toUVMType(variant.type)}, ${variant.opcode}},\n`;
+                });
+                buffer += `${tab(2)}},\n`;
+            }
 
-            buffer += `${tab(2)}},\n`;
+            buffer += `${tab(1)}},\n`;
         });
-        buffer += `${tab(1)}},\n`;
     });
-    // Closing brace of 'constexpr std::array<InstrParamList> INSTR_ASM_DEFS {\n'
+    buffer += '}};\n\n';
+
+    return buffer;
+}
+
+/**
+ * Hashes a keyword. This must produce the same result as keywordHash() in
+ * asm.hpp
+ * @param {string} str Keyword
+ * @param {number} seed Hash seed
+ * @return {number} 32-bit unsigned hash
+ */
+function keywordHash(str, seed) {
+    let hash = (seed ^ str.length) >>> 0;
+    for (let i = 0; i < str.length; i++) {
+        hash = Math.imul(hash ^ str.charCodeAt(i), 0x01000193) >>> 0;
+    }
+    return hash;
+}
+
+/**
+ * Tries to find a displacement for every bucket so that no two keywords end up
+ * in the same table slot. A keyword is placed at slot
+ * ((hash >> 16) + displacement[hash & (bucketCount - 1)]) & (tableSize - 1).
+ * This must match findKeyword() in asm.cpp
+ * @param {Array} keywords Keyword entries
+ * @param {number} seed Hash seed
+ * @return {?Array} Displacement per bucket or null if none was found
+ */
+function findDisplacements(keywords, seed) {
+    const buckets = [];
+    for (let i = 0; i < KEYWORD_BUCKET_COUNT; i++) {
+        buckets.push({ index: i, keys: [] });
+    }
+    keywords.forEach((keyword) => {
+        const hash = keywordHash(keyword.name, seed);
+        buckets[hash & (KEYWORD_BUCKET_COUNT - 1)].keys.push(hash >>> 16);
+    });
+
+    // Place the biggest buckets first while the table is still empty
+    buckets.sort((a, b) => b.keys.length - a.keys.length);
+
+    const used = new Array(KEYWORD_TABLE_SIZE).fill(false);
+    const displacements = new Array(KEYWORD_BUCKET_COUNT).fill(0);
+    for (const bucket of buckets) {
+        let found = false;
+        for (let d = 0; d < KEYWORD_TABLE_SIZE && !found; d++) {
+            const slots = bucket.keys.map((k) => (k + d) & (KEYWORD_TABLE_SIZE - 1));
+            const distinct = new Set(slots).size === slots.length;
+            if (distinct && slots.every((slot) => !used[slot])) {
+                slots.forEach((slot) => used[slot] = true);
+                displacements[bucket.index] = d;
+                found = true;
+            }
+        }
+        if (!found) {
+            return null;
+        }
+    }
+    return displacements;
+}
+
+/**
+ * Generates the perfect hash table used by the scanner to classify words as
+ * instruction, type info or register
+ * @param {*} data JSON data
+ * @return {string} generated C++ code
+ */
+function generateKeywordTable(data) {
+    const keywords = [];
+    data.instructions.forEach((instr, i) => {
+        keywords.push({ name: instr.name, type: 'INSTRUCTION', tag: `${i}` });
+    });
+    Object.entries(KEYWORD_TYPES).forEach(([name, type]) => {
+        keywords.push({ name: name, type: 'TYPE_INFO', tag: type });
+    });
+    data.registers.forEach((reg) => {
+        keywords.push({ name: reg.name, type: 'REGISTER_DEFINITION', tag: reg.bytecode });
+    });
+
+    // Search for a seed for which every bucket can be displaced without
+    // collisions
+    let seed = 0;
+    let displacements = findDisplacements(keywords, seed);
+    while (displacements === null) {
+        seed++;
+        displacements = findDisplacements(keywords, seed);
+    }
+
+    const table = new Array(KEYWORD_TABLE_SIZE).fill(null);
+    keywords.forEach((keyword) => {
+        const hash = keywordHash(keyword.name, seed);
+        const d = displacements[hash & (KEYWORD_BUCKET_COUNT - 1)];
+        table[((hash >>> 16) + d) & (KEYWORD_TABLE_SIZE - 1)] = keyword;
+    });
+    const maxSize = Math.max(...keywords.map((keyword) => keyword.name.length));
+
+    let buffer = '// Perfect hash table of every keyword (instruction names, type names and\n';
+    buffer += '// register names). See findKeyword() in asm.cpp for how a slot is found\n';
+    buffer += `constexpr uint32_t KEYWORD_HASH_SEED = ${seed};\n`;
+    buffer += `constexpr uint32_t KEYWORD_MAX_SIZE = ${maxSize};\n`;
+    buffer += `constexpr uint32_t KEYWORD_TABLE_SIZE = ${KEYWORD_TABLE_SIZE};\n`;
+    buffer += `constexpr uint32_t KEYWORD_BUCKET_COUNT = ${KEYWORD_BUCKET_COUNT};\n\n`;
+
+    buffer += 'constexpr std::array<uint8_t, KEYWORD_BUCKET_COUNT> KEYWORD_DISPLACEMENTS{\n';
+    for (let i = 0; i < displacements.length; i += 16) {
+        const row = displacements.slice(i, i + 16).map((d) => `${d},`);
+        buffer += `${tab(1)}${row.join(' ')}\n`;
+    }
     buffer += '};\n\n';
+
+    buffer += 'constexpr std::array<KeywordEntry, KEYWORD_TABLE_SIZE> KEYWORD_TABLE{{\n';
+    table.forEach((keyword) => {
+        if (keyword === null) {
+            buffer += `${tab(1)}{},\n`;
+        } else {
+            buffer += `${tab(1)}{"${keyword.name}", ${keyword.name.length}, TokenType::${keyword.type}, ${keyword.tag}},\n`;
+        }
+    });
+    buffer += '}};\n\n';
+
+    return buffer;
+}
+
+/**
+ *
+ * @param {*} data JSON data from file
+ */
+function generateHeaderFile(data) {
+    // Create new output buffer and insert .hpp header
+    let buffer = `${HEADER}\n`;
+
+    // Add namespace
+    buffer += 'namespace Asm {\n';
+
+    const encoders = collectEncoders(data);
+    buffer += generateEncoderTable(encoders);
+    buffer += generateParamListTable(data);
+    buffer += generateKeywordTable(data);
     buffer += '} // namespace Asm\n'; // Namespace closing bracket
 
     return buffer;
@@ -15,19 +15,20 @@
 // ======================================================================== //
 
 #include "assembler.hpp"
+#include "fileMap.hpp"
 #include "generator.hpp"
 #include "parser.hpp"
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <thread>
 
 /**
  * Constructs a new Assembler
- * @param instrDefs Vector of instruction definitons
  * @param inFile Source file path
  * @param outFile Output file path. Use default by passing nullptr
  */
-Assembler::Assembler(std::vector<InstrDefNode>* instrDefs, char* inFile)
-    : InstrDefs(instrDefs), InFile(inFile) {}
+Assembler::Assembler(char* inFile) : InFile(inFile) {}
 
 /**
  * Assembler destructor
@@ -57,6 +58,15 @@ bool Assembler::setOutputDir(char* dir) {
     return true;
 }
 
+/**
+ * Enables scanning large source files on multiple threads. All tokens are
+ * scanned before parsing then instead of in small batches while parsing
+ * @param enable Scan on multiple threads if true
+ */
+void Assembler::setParallelScan(bool enable) {
+    ParallelScan = enable;
+}
+
 /**
  * Reads the previously set source file into a buffer
  * @return On success return true otherwise false
@@ -66,18 +76,31 @@ bool Assembler::readSource() {
         return false;
     }
 
+    // Map regular files directly into memory
     uint32_t size = 0;
-    // Get source file size
-    std::ifstream stream{InFile};
-    stream.seekg(0, std::ios::end);
-    size = stream.tellg();
-    stream.seekg(0, std::ios::beg);
+    uint8_t* mapped = mapFile(InFile.string().c_str(), SOURCE_PADDING, size);
+    if (mapped != nullptr) {
+        Src = new SourceFile(mapped, size);
+        return true;
+    }
 
-    // Write complete file into buffer
-    uint8_t* buffer = new uint8_t[size];
-    stream.read((char*)buffer, size);
+    // Otherwise read the complete file into a buffer
+    std::ifstream stream{InFile, std::ios::binary};
+    stream.seekg(0, std::ios::end);
+    std::streamoff end = stream.tellg();
+    if (end >= 0) {
+        stream.seekg(0, std::ios::beg);
+        Src = new SourceFile(end);
+        stream.read((char*)Src->getData(), end);
+        return true;
+    }
 
-    Src = new SourceFile(buffer, size);
+    // Pipes and special files have no size and are read until the end
+    stream.clear();
+    std::vector<char> content{std::istreambuf_iterator<char>(stream),
+                              std::istreambuf_iterator<char>()};
+    Src = new SourceFile(content.size());
+    std::memcpy(Src->getData(), content.data(), content.size());
 
     return true;
 }
@@ -87,19 +110,30 @@ bool Assembler::readSource() {
  * @return On success returns true otherwise false
  */
 bool Assembler::assemble() {
-    // Initialize components
+    // Initialize components. Source files of any size are scanned while
+    // parsing so that only a small batch of tokens is held at once
     Scan = new Scanner{Src, &Tokens};
-
-    bool scanSucc = Scan->scanSource();
-    if (!scanSucc) {
-        return false;
+    uint32_t threadCount = std::thread::hardware_concurrency();
+
+    // Scanning on multiple threads has to be requested, it holds all tokens
+    // at once and has not been shown to scale yet
+    if (ParallelScan) {
+        bool scanSucc = Scan->scanSourceParallel(threadCount);
+        if (!scanSucc) {
+            return false;
+        }
     }
 
     ASTFileNode fileNode{};
-    std::vector<LabelDefLookup> labelDefs;
+    SymbolTable symbols;
     std::vector<VarDeclaration> VarDecls;
+    // Decoded strings of the whole source file
+    std::vector<uint8_t> strings;
+    // Owns every AST node, they are all released once assembling is done
+    ASTArena nodes;
 
-    Parser parse{InstrDefs, Src, &Tokens, &fileNode, &labelDefs, &VarDecls};
+    Parser parse{Src,      Scan,     &fileNode, &symbols,
+                 &VarDecls, &strings, &nodes};
     bool astSucc = parse.buildAST();
     if (!astSucc) {
         return false;
@@ -110,7 +144,8 @@ bool Assembler::assemble() {
         return false;
     }
 
-    Generator gen{&fileNode, &OutFile, &labelDefs, &VarDecls};
+    Generator gen{&fileNode, &OutFile, &symbols, &VarDecls, &strings,
+                  threadCount};
     gen.genBinary();
 
     return true;
@@ -26,18 +26,20 @@
 
 class Assembler {
   public:
-    Assembler(std::vector<InstrDefNode>* instrDefs, char* inFile);
+    Assembler(char* inFile);
     ~Assembler();
     bool setOutputDir(char* dir);
+    void setParallelScan(bool enable);
     bool readSource();
     bool assemble();
 
   private:
-    /** Non owning pointer to instuction definitons */
-    std::vector<InstrDefNode>* InstrDefs = nullptr;
     SourceFile* Src = nullptr;
     Scanner* Scan = nullptr;
-    std::vector<Token> Tokens;
+    /** Tokens which the scanner hands out to the parser */
+    TokenStream Tokens;
     std::filesystem::path InFile;
     std::filesystem::path OutFile;
+    /** Scan large source files on multiple threads before parsing */
+    bool ParallelScan = false;
 };
@@ -15,101 +15,100 @@
 // ======================================================================== //
 
 #include "ast.hpp"
+#include "pages.hpp"
+#include <utility>
 
 ASTNode::ASTNode(ASTType type) : Type(type) {}
 
-ASTNode::ASTNode(ASTType type,
-                 uint32_t pos,
-                 uint32_t size,
-                 uint32_t lineNr,
-                 uint32_t lineCol)
-    : Type(type), Index(pos), Size(size), LineRow(lineNr), LineCol(lineCol) {}
+ASTNode::ASTNode(ASTType type, uint32_t pos, uint32_t size)
+    : Type(type), Index(pos), Size(size) {}
 
 ASTSection::ASTSection(uint32_t pos,
                        uint32_t size,
-                       uint32_t lineNr,
-                       uint32_t lineCol,
-                       std::string name,
+                       std::string_view name,
                        ASTSectionType secType)
-    : ASTNode(ASTType::VARIABLE, pos, size, lineNr, lineCol), Name(name),
-      SecType(secType) {}
+    : ASTNode(ASTType::SECTION, pos, size), Name(name), SecType(secType) {}
 
 ASTVariable::ASTVariable(uint32_t pos,
                          uint32_t size,
-                         uint32_t lineNr,
-                         uint32_t lineCol,
                          Identifier* id,
                          TypeInfo* dataType,
                          ASTNode* val)
-    : ASTNode(ASTType::SECTION, pos, size, lineNr, lineCol), Id(id),
-      DataType(dataType), Val(val) {}
+    : ASTNode(ASTType::VARIABLE, pos, size), Id(id), DataType(dataType),
+      Val(val) {}
 
 LabelDef::LabelDef(uint32_t pos,
                    uint32_t size,
-                   uint32_t lineNr,
-                   uint32_t lineCol,
-                   std::string name)
-    : ASTNode(ASTType::LABEL_DEFINITION, pos, size, lineNr, lineCol),
-      Name(name) {}
+                   uint32_t symbolId,
+                   uint32_t instrIndex)
+    : ASTNode(ASTType::LABEL_DEFINITION, pos, size), SymbolId(symbolId),
+      InstrIndex(instrIndex) {}
 
-Identifier::Identifier(uint32_t pos,
-                       uint32_t size,
-                       uint32_t lineNr,
-                       uint32_t lineCol,
-                       std::string name)
-    : ASTNode(ASTType::IDENTIFIER, pos, size, lineNr, lineCol), Name(name) {}
-
-Instruction::Instruction(uint32_t pos,
-                         uint32_t size,
-                         uint32_t lineNr,
-                         uint32_t lineCol,
-                         std::string name,
-                         uint32_t asmDefIndex)
-    : ASTNode(ASTType::INSTRUCTION, pos, size, lineNr, lineCol), Name(name),
-      ASMDefIndex(asmDefIndex) {}
+Identifier::Identifier(uint32_t pos, uint32_t size, uint32_t symbolId)
+    : ASTNode(ASTType::IDENTIFIER, pos, size), SymbolId(symbolId) {}
 
-ASTFloat::ASTFloat(
-    uint32_t pos, uint32_t size, uint32_t lineNr, uint32_t lineCol, double num)
-    : ASTNode(ASTType::FLOAT_NUMBER, pos, size, lineNr, lineCol), Num(num) {}
+ASTFloat::ASTFloat(uint32_t pos, uint32_t size, double num, bool exceedsF32)
+    : ASTNode(ASTType::FLOAT_NUMBER, pos, size), Num(num),
+      ExceedsF32(exceedsF32) {}
 
 ASTInt::ASTInt() : ASTNode(ASTType::INTEGER_NUMBER) {}
 
-ASTInt::ASTInt(uint32_t pos,
-               uint32_t size,
-               uint32_t lineNr,
-               uint32_t lineCol,
-               int64_t num,
-               bool isSigned)
-    : ASTNode(ASTType::INTEGER_NUMBER, pos, size, lineNr, lineCol), Num(num),
+ASTInt::ASTInt(uint32_t pos, uint32_t size, int64_t num, bool isSigned)
+    : ASTNode(ASTType::INTEGER_NUMBER, pos, size), Num(num),
       IsSigned(isSigned) {}
 
-RegisterId::RegisterId(
-    uint32_t pos, uint32_t size, uint32_t lineNr, uint32_t lineCol, uint8_t id)
-    : ASTNode(ASTType::REGISTER_ID, pos, size, lineNr, lineCol), Id(id) {}
-
-RegisterOffset::RegisterOffset() : ASTNode(ASTType::REGISTER_OFFSET){};
-
-RegisterOffset::RegisterOffset(uint32_t pos,
-                               uint32_t size,
-                               uint32_t lineNr,
-                               uint32_t lineCol,
-                               uint8_t layout,
-                               RegisterId* base,
-                               RegisterId* offset)
-    : ASTNode(ASTType::REGISTER_OFFSET, pos, size, lineNr, lineCol),
-      Layout(layout), Base(base), Offset(offset) {}
-
-TypeInfo::TypeInfo(uint32_t pos,
-                   uint32_t size,
-                   uint32_t lineNr,
-                   uint32_t lineCol,
-                   uint8_t dataType)
-    : ASTNode(ASTType::TYPE_INFO, pos, size, lineNr, lineCol),
-      DataType(dataType) {}
+TypeInfo::TypeInfo(uint32_t pos, uint32_t size, uint8_t dataType)
+    : ASTNode(ASTType::TYPE_INFO, pos, size), DataType(dataType) {}
 
 ASTString::ASTString(uint32_t pos,
                      uint32_t size,
-                     uint32_t lineNr,
-                     uint32_t lineCol,
-                     std::string val)
-    : ASTNode(ASTType::STRING, pos, size, lineNr, lineCol), Val(val) {}
+                     uint32_t arenaIndex,
+                     uint32_t length)
+    : ASTNode(ASTType::STRING, pos, size), ArenaIndex(arenaIndex),
+      Length(length) {}
+
+ASTArena::~ASTArena() {
+    release();
+}
+
+/**
+ * Destroys all nodes and frees all chunks of the arena
+ */
+void ASTArena::release() {
+    for (auto node = Nodes.rbegin(); node != Nodes.rend(); node++) {
+        (*node)->~ASTNode();
+    }
+    Nodes.clear();
+
+    for (void* chunk : Chunks) {
+        freePages(chunk, AST_ARENA_CHUNK_SIZE);
+    }
+    Chunks.clear();
+    Cursor = nullptr;
+    End = nullptr;
+}
+
+/**
+ * Allocates memory for a node from the current chunk or from a new chunk if
+ * the current one is full
+ * @param size Size of the node
+ * @param align Alignment of the node
+ * @return Pointer to the memory
+ */
+void* ASTArena::allocate(size_t size, size_t align) {
+    size_t padding = (align - (uintptr_t)Cursor % align) % align;
+    if (Cursor == nullptr || padding + size > (size_t)(End - Cursor)) {
+        void* chunk = allocatePages(AST_ARENA_CHUNK_SIZE);
+        if (chunk == nullptr) {
+            throw std::bad_alloc();
+        }
+        Chunks.push_back(chunk);
+        Cursor = (uint8_t*)chunk;
+        End = &Cursor[AST_ARENA_CHUNK_SIZE];
+        padding = 0;
+    }
+
+    uint8_t* mem = &Cursor[padding];
+    Cursor = &mem[size];
+    return mem;
+}
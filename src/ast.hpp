@@ -17,19 +17,22 @@
 #pragma once
 #include "asm/asm.hpp"
 #include "token.hpp"
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
+#include <new>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 enum class ASTType {
     GLOBAL,
     LABEL_DEFINITION,
     IDENTIFIER,
-    INSTRUCTION,
     FLOAT_NUMBER,
     INTEGER_NUMBER,
-    REGISTER_ID,
-    REGISTER_OFFSET,
     TYPE_INFO,
     SECTION,
     VARIABLE,
@@ -56,29 +59,26 @@ constexpr uint8_t RO_LAYOUT_IR = 0x4F;        // <iR>
 constexpr uint8_t RO_LAYOUT_IR_INT = 0x2F;    // <iR> + <i32>
 constexpr uint8_t RO_LAYOUT_IR_IR_INT = 0x1F; // <iR> + <iR> * <i16>
 
+/**
+ * Base of all AST nodes. The hierarchy is closed, every node class sets the
+ * Type tag to its NODE_TYPE and nodeCast relies on the tag instead of RTTI
+ */
 class ASTNode {
   public:
     ASTNode(ASTType type);
-    ASTNode(ASTType type,
-            uint32_t pos,
-            uint32_t size,
-            uint32_t lineNr,
-            uint32_t lineCol);
+    ASTNode(ASTType type, uint32_t pos, uint32_t size);
     ASTType Type;
     uint32_t Index;
     uint32_t Size;
-    uint32_t LineRow;
-    uint32_t LineCol;
     virtual ~ASTNode() = default;
 };
 
 class ASTSection : public ASTNode {
   public:
+    static constexpr ASTType NODE_TYPE = ASTType::SECTION;
     ASTSection(uint32_t pos,
                uint32_t size,
-               uint32_t lineNr,
-               uint32_t lineCol,
-               std::string name,
+               std::string_view name,
                ASTSectionType secType);
     ASTSectionType SecType;
     std::string Name;
@@ -87,114 +87,57 @@ class ASTSection : public ASTNode {
 
 class LabelDef : public ASTNode {
   public:
+    static constexpr ASTType NODE_TYPE = ASTType::LABEL_DEFINITION;
     LabelDef(uint32_t pos,
              uint32_t size,
-             uint32_t lineNr,
-             uint32_t lineCol,
-             std::string name);
-    std::string Name;
+             uint32_t symbolId,
+             uint32_t instrIndex);
+    /** Symbol id of the label name */
+    uint32_t SymbolId = 0;
+    /** Index of the instruction record which follows the label */
+    uint32_t InstrIndex = 0;
 };
 
 class Identifier : public ASTNode {
   public:
-    Identifier(uint32_t pos,
-               uint32_t size,
-               uint32_t lineNr,
-               uint32_t lineCol,
-               std::string name);
-    std::string Name;
-};
-
-class Instruction : public ASTNode {
-  public:
-    Instruction(uint32_t pos,
-                uint32_t size,
-                uint32_t lineNr,
-                uint32_t lineCol,
-                std::string name,
-                uint32_t asmDefIndex);
-    std::string Name;
-    std::vector<ASTNode*> Params;
-    uint32_t ASMDefIndex = 0;
-    uint8_t Opcode = 0;
-    uint8_t EncodingFlags = 0;
-    // TODO: This should not be needed by the generator
-    InstrParamList* ParamList = nullptr;
+    static constexpr ASTType NODE_TYPE = ASTType::IDENTIFIER;
+    Identifier(uint32_t pos, uint32_t size, uint32_t symbolId);
+    /** Symbol id of the name */
+    uint32_t SymbolId = 0;
 };
 
 class ASTFloat : public ASTNode {
   public:
-    ASTFloat(uint32_t pos,
-             uint32_t size,
-             uint32_t lineNr,
-             uint32_t lineCol,
-             double num);
+    static constexpr ASTType NODE_TYPE = ASTType::FLOAT_NUMBER;
+    ASTFloat(uint32_t pos, uint32_t size, double num, bool exceedsF32);
     double Num;
     uint8_t DataType;
+    /** Absolute value is too large for a 32-bit float */
+    bool ExceedsF32 = false;
 };
 
 class ASTInt : public ASTNode {
   public:
+    static constexpr ASTType NODE_TYPE = ASTType::INTEGER_NUMBER;
     ASTInt();
-    ASTInt(uint32_t pos,
-           uint32_t size,
-           uint32_t lineNr,
-           uint32_t lineCol,
-           int64_t num,
-           bool isSigned);
+    ASTInt(uint32_t pos, uint32_t size, int64_t num, bool isSigned);
     int64_t Num;
     uint8_t DataType;
     bool IsSigned = false;
 };
 
-class RegisterId : public ASTNode {
-  public:
-    RegisterId(uint32_t pos,
-               uint32_t size,
-               uint32_t lineNr,
-               uint32_t lineCol,
-               uint8_t id);
-    uint8_t Id;
-};
-
-union ROInt {
-    uint16_t U16;
-    uint32_t U32 = 0;
-};
-
-class RegisterOffset : public ASTNode {
-  public:
-    RegisterOffset();
-    RegisterOffset(uint32_t pos,
-                   uint32_t size,
-                   uint32_t lineNr,
-                   uint32_t lineCol,
-                   uint8_t layout,
-                   RegisterId* base,
-                   RegisterId* offset);
-    uint8_t Layout = 0;
-    RegisterId* Base = nullptr;
-    RegisterId* Offset = nullptr;
-    ROInt Immediate;
-    Identifier* Var = nullptr;
-};
-
 class TypeInfo : public ASTNode {
   public:
-    TypeInfo(uint32_t pos,
-             uint32_t size,
-             uint32_t lineNr,
-             uint32_t lineCol,
-             uint8_t dataType);
+    static constexpr ASTType NODE_TYPE = ASTType::TYPE_INFO;
+    TypeInfo(uint32_t pos, uint32_t size, uint8_t dataType);
     uint8_t DataType;
 };
 
 class ASTVariable : public ASTNode {
   public:
+    static constexpr ASTType NODE_TYPE = ASTType::VARIABLE;
     ASTVariable(uint32_t pos,
                 uint32_t size,
-                uint32_t lineNr,
-                uint32_t lineCol,
                 Identifier* id,
                 TypeInfo* dataType,
                 ASTNode* val);
@@ -206,12 +149,106 @@ class ASTVariable : public ASTNode {
 
 class ASTString : public ASTNode {
   public:
+    static constexpr ASTType NODE_TYPE = ASTType::STRING;
     ASTString(uint32_t pos,
               uint32_t size,
-              uint32_t lineNr,
-              uint32_t lineCol,
-              std::string val);
-    std::string Val;
+              uint32_t arenaIndex,
+              uint32_t length);
+    /** Index of the decoded string in the string arena */
+    uint32_t ArenaIndex = 0;
+    /** Size of the decoded string */
+    uint32_t Length = 0;
+};
+
+/**
+ * Casts a node down to its node class. The Type tag already determines the
+ * class of every node so no runtime type information is needed
+ * @param node Node whose Type matches T::NODE_TYPE
+ * @return Pointer to the node as its node class
+ */
+template <typename T> T* nodeCast(ASTNode* node) {
+    assert(node->Type == T::NODE_TYPE);
+    return static_cast<T*>(node);
+}
+
+/** Maximum amount of operands an instruction record holds */
+constexpr uint32_t MAX_INSTR_OPERANDS = 4;
+static_assert(MAX_INSTR_OPERANDS <= MAX_SIGNATURE_PARAMS,
+              "Packed signatures must hold every operand");
+
+enum class OperandType : uint8_t {
+    TYPE_INFO,
+    REGISTER_ID,
+    REGISTER_OFFSET,
+    INTEGER_NUMBER,
+    FLOAT_NUMBER,
+    IDENTIFIER,
+};
+
+/** Flag of an integer operand which has been negated */
+constexpr uint8_t OPERAND_FLAG_SIGNED = 0x1;
+/** Flag of a float operand whose absolute value does not fit into 32 bits */
+constexpr uint8_t OPERAND_FLAG_EXCEEDS_F32 = 0x2;
+/** Flag of a register offset which refers to a variable like "[staticVar]" */
+constexpr uint8_t OPERAND_FLAG_VARIABLE = 0x4;
+
+/**
+ * A single operand of an instruction record. Which fields are used depends on
+ * the operand type
+ */
+struct Operand {
+    OperandType Type = OperandType::TYPE_INFO;
+    /** OPERAND_FLAG_* */
+    uint8_t Flags = 0;
+    /**
+     * Data type of a type info or the data type an integer or float number is
+     * encoded as which is determined by the type checker
+     */
+    uint8_t DataType = 0;
+    /** Register id or base register of a register offset */
+    uint8_t Reg = 0;
+    /** Offset register of a register offset */
+    uint8_t OffsetReg = 0;
+    /** RO_LAYOUT_* of a register offset */
+    uint8_t Layout = 0;
+    /**
+     * Position of the operand in the source file. Register offsets which
+     * refer to a variable point to the variable name
+     */
+    uint32_t Index = 0;
+    /** Size of the operand string in the source file */
+    uint32_t Size = 0;
+    /**
+     * Integer or float number, immediate of a register offset or the symbol id
+     * of the label or variable an identifier refers to
+     */
+    Literal Value;
+};
+
+/**
+ * A single instruction of the code section. The records are stored in one
+ * contiguous array and hold their operands inline
+ */
+struct InstrRecord {
+    /** Position of the instruction name in the source file */
+    uint32_t Index = 0;
+    /** Size of the instruction name */
+    uint32_t Size = 0;
+    /** Index of the instruction definition */
+    uint8_t ASMDefIndex = 0;
+    uint8_t Opcode = 0;
+    uint8_t EncodingFlags = 0;
+    /**
+     * Amount of parsed operands. This is MAX_INSTR_OPERANDS + 1 if there are
+     * more operands than the record can hold
+     */
+    uint8_t OperandCount = 0;
+    /**
+     * Index of the encoder in Asm::INSTR_ENCODERS which is selected by the type
+     * checker, see encoder.hpp
+     */
+    uint8_t Encoder = 0;
+    Operand Operands[MAX_INSTR_OPERANDS];
 };
 
 class ASTFileNode {
@@ -220,18 +257,52 @@ class ASTFileNode {
     ASTSection* SecStatic = nullptr;
     ASTSection* SecGlobal = nullptr;
     ASTSection* SecCode = nullptr;
+    /** Instructions of the code section in order of appearance */
+    std::vector<InstrRecord> Instrs;
+    /** Label definitions of the code section in order of appearance */
+    std::vector<LabelDef*> Labels;
 };
 
 /**
- * This is used by the parser to check if a label reference is resolved. In
- * the generator stage this is used to fill out the placeholder addresses of
- * label references with the VAddr member. The VAddr member will be filled
- * out by the generator once it loops through the AST and generates the
- * instructions.
+ * Size of the memory chunks of the ASTArena. It matches the size of a huge page
+ */
+constexpr size_t AST_ARENA_CHUNK_SIZE = 2 * 1024 * 1024;
+
+/**
+ * Owns all nodes of an AST. The nodes are placed one after another into large
+ * chunks of memory and are all destroyed at once together with the arena
  */
-struct LabelDefLookup {
-    /** Non owning pointer to the label definition node */
-    LabelDef* Def = nullptr;
-    /** Used by the generator to lookup function references */
-    uint64_t VAddr = 0;
+class ASTArena {
+  public:
+    ASTArena() = default;
+    ASTArena(const ASTArena&) = delete;
+    ASTArena& operator=(const ASTArena&) = delete;
+    ~ASTArena();
+    template <typename T, typename... Args> T* create(Args&&... args);
+    void release();
+
+  private:
+    /** Chunks of AST_ARENA_CHUNK_SIZE bytes */
+    std::vector<void*> Chunks;
+    /** Pointer to the free memory of the current chunk */
+    uint8_t* Cursor = nullptr;
+    /** Pointer behind the current chunk */
+    uint8_t* End = nullptr;
+    /** Every node in order of creation, they are destroyed in reverse order */
+    std::vector<ASTNode*> Nodes;
+    void* allocate(size_t size, size_t align);
 };
+
+/**
+ * Creates a new node inside of the arena
+ * @param args Arguments which are passed to the node constructor
+ * @return Pointer to the node which is owned by the arena
+ */
+template <typename T, typename... Args> T* ASTArena::create(Args&&... args) {
+    static_assert(std::is_base_of_v<ASTNode, T>, "Arena only holds AST nodes");
+    void* mem = allocate(sizeof(T), alignof(T));
+    T* node = new (mem) T(std::forward<Args>(args)...);
+    Nodes.push_back(node);
+    return node;
+}
+
@@ -0,0 +1,259 @@
+// ======================================================================== //
+// Copyright 2021 Michel Fäh
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ======================================================================== //
+
+#include "byteSearch.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define BASS_X86_64
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_SSE42 __attribute__((target("sse4.2")))
+#else
+#define TARGET_AVX2
+#define TARGET_SSE42
+#endif
+
+/**
+ * Signature of a search implementation. All of them return a pointer to the
+ * first byte in [begin, end) which is equal to one of a, b or c. If negate is
+ * set the first byte which is equal to none of them is returned instead. If no
+ * byte matches end is returned.
+ */
+using SearchFn = const uint8_t* (*)(const uint8_t* begin,
+                                    const uint8_t* end,
+                                    uint8_t a,
+                                    uint8_t b,
+                                    uint8_t c,
+                                    bool negate);
+
+/**
+ * Scalar search implementation used on the tail of a buffer and as a fallback
+ */
+static const uint8_t* searchScalar(const uint8_t* begin,
+                                   const uint8_t* end,
+                                   uint8_t a,
+                                   uint8_t b,
+                                   uint8_t c,
+                                   bool negate) {
+    for (; begin < end; begin++) {
+        uint8_t v = *begin;
+        bool match = v == a || v == b || v == c;
+        if (match != negate) {
+            return begin;
+        }
+    }
+    return end;
+}
+
+#ifdef BASS_X86_64
+/**
+ * Returns the index of the lowest set bit. Mask must not be 0
+ */
+static uint32_t lowestBit(uint32_t mask) {
+#ifdef _MSC_VER
+    unsigned long index = 0;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+/**
+ * AVX2 search implementation which compares 32 bytes at a time
+ */
+TARGET_AVX2 static const uint8_t* searchAVX2(const uint8_t* begin,
+                                             const uint8_t* end,
+                                             uint8_t a,
+                                             uint8_t b,
+                                             uint8_t c,
+                                             bool negate) {
+    const __m256i va = _mm256_set1_epi8(static_cast<char>(a));
+    const __m256i vb = _mm256_set1_epi8(static_cast<char>(b));
+    const __m256i vc = _mm256_set1_epi8(static_cast<char>(c));
+    const uint32_t flip = negate ? 0xFFFFFFFF : 0;
+
+    while (end - begin >= 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+        __m256i eq = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, va), _mm256_cmpeq_epi8(v, vb)),
+            _mm256_cmpeq_epi8(v, vc));
+        uint32_t mask =
+            static_cast<uint32_t>(_mm256_movemask_epi8(eq)) ^ flip;
+        if (mask != 0) {
+            return begin + lowestBit(mask);
+        }
+        begin += 32;
+    }
+    return searchScalar(begin, end, a, b, c, negate);
+}
+
+/**
+ * SSE4.2 search implementation which uses PCMPESTRI to compare 16 bytes at a
+ * time against the byte set
+ */
+TARGET_SSE42 static const uint8_t* searchSSE42(const uint8_t* begin,
+                                               const uint8_t* end,
+                                               uint8_t a,
+                                               uint8_t b,
+                                               uint8_t c,
+                                               bool negate) {
+    const __m128i set =
+        _mm_setr_epi8(static_cast<char>(a), static_cast<char>(b),
+                      static_cast<char>(c), 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                      0);
+
+    if (negate) {
+        constexpr int MODE = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY |
+                             _SIDD_NEGATIVE_POLARITY | _SIDD_LEAST_SIGNIFICANT;
+        while (end - begin >= 16) {
+            __m128i v =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+            int index = _mm_cmpestri(set, 3, v, 16, MODE);
+            if (index != 16) {
+                return begin + index;
+            }
+            begin += 16;
+        }
+    } else {
+        constexpr int MODE =
+            _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT;
+        while (end - begin >= 16) {
+            __m128i v =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+            int index = _mm_cmpestri(set, 3, v, 16, MODE);
+            if (index != 16) {
+                return begin + index;
+            }
+            begin += 16;
+        }
+    }
+    return searchScalar(begin, end, a, b, c, negate);
+}
+
+/**
+ * Checks if the CPU and the operating system support AVX2
+ */
+static bool hasAVX2() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    // OSXSAVE and AVX bits
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0) {
+        return false;
+    }
+    // Check if the OS saves the YMM registers
+    if ((_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+/**
+ * Checks if the CPU supports SSE4.2
+ */
+static bool hasSSE42() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0;
+#else
+    return __builtin_cpu_supports("sse4.2");
+#endif
+}
+#endif
+
+/**
+ * Selects the fastest search implementation supported by the CPU
+ * @return Pointer to search implementation
+ */
+static SearchFn selectSearch() {
+#ifdef BASS_X86_64
+    if (hasAVX2()) {
+        return searchAVX2;
+    }
+    if (hasSSE42()) {
+        return searchSSE42;
+    }
+#endif
+    return searchScalar;
+}
+
+/**
+ * Runs the search implementation which has been selected for this CPU
+ */
+static const uint8_t* search(const uint8_t* begin,
+                             const uint8_t* end,
+                             uint8_t a,
+                             uint8_t b,
+                             uint8_t c,
+                             bool negate) {
+    static const SearchFn impl = selectSearch();
+    return impl(begin, end, a, b, c, negate);
+}
+
+/**
+ * Skips a run of spaces and tabs
+ * @param begin Pointer to first byte
+ * @param end Pointer past the last byte
+ * @return Pointer to the first byte which is neither a space nor a tab or end
+ */
+const uint8_t* skipBlanks(const uint8_t* begin, const uint8_t* end) {
+    return search(begin, end, ' ', '\t', '\t', true);
+}
+
+/**
+ * Finds the first occurrence of a byte
+ * @param begin Pointer to first byte
+ * @param end Pointer past the last byte
+ * @param a Byte to search for
+ * @return Pointer to the first occurrence or end if there is none
+ */
+const uint8_t* findByte(const uint8_t* begin, const uint8_t* end, uint8_t a) {
+    return search(begin, end, a, a, a, false);
+}
+
+/**
+ * Finds the first occurrence of either a or b
+ * @param begin Pointer to first byte
+ * @param end Pointer past the last byte
+ * @return Pointer to the first occurrence or end if there is none
+ */
+const uint8_t*
+findAnyOf(const uint8_t* begin, const uint8_t* end, uint8_t a, uint8_t b) {
+    return search(begin, end, a, b, b, false);
+}
+
+/**
+ * Finds the first occurrence of either a, b or c
+ * @param begin Pointer to first byte
+ * @param end Pointer past the last byte
+ * @return Pointer to the first occurrence or end if there is none
+ */
+const uint8_t* findAnyOf(
+    const uint8_t* begin, const uint8_t* end, uint8_t a, uint8_t b, uint8_t c) {
+    return search(begin, end, a, b, c, false);
+}
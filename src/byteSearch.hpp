@@ -0,0 +1,29 @@
+// ======================================================================== //
+// Copyright 2021 Michel Fäh
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ======================================================================== //
+
+#pragma once
+#include <cstdint>
+
+// These functions are used by the scanner to skip over large runs of bytes
+// which do not produce tokens. On x86-64 they use AVX2 or SSE4.2 depending on
+// what the CPU supports, on every other platform a scalar loop is used.
+
+const uint8_t* skipBlanks(const uint8_t* begin, const uint8_t* end);
+const uint8_t* findByte(const uint8_t* begin, const uint8_t* end, uint8_t a);
+const uint8_t*
+findAnyOf(const uint8_t* begin, const uint8_t* end, uint8_t a, uint8_t b);
+const uint8_t* findAnyOf(
+    const uint8_t* begin, const uint8_t* end, uint8_t a, uint8_t b, uint8_t c);
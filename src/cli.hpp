@@ -20,6 +20,4 @@
 void printError(SourceFile* src,
                 uint32_t index,
                 uint32_t size,
-                uint32_t row,
-                uint32_t column,
                 const char* msg);
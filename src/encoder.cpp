@@ -0,0 +1,60 @@
+// ======================================================================== //
+// Copyright 2021 Michel Fäh
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ======================================================================== //
+
+#include "encoder.hpp"
+#include "parser.hpp"
+#include <cstring>
+
+/**
+ * Encodes a register offset. All 6 bytes are written, the bytes which the
+ * layout does not use are zero
+ * @param regOff Register offset operand
+ * @param ctx Addresses of the labels and variables
+ * @param out Pointer to the 6 bytes which receive the register offset
+ */
+void encodeRegisterOffset(const Operand& regOff,
+                          const EncodeContext& ctx,
+                          uint8_t* out) {
+    constexpr uint8_t REG_IP = 0x1;
+
+    // A variable offset is encoded as an offset relative to the instruction
+    // pointer which points to the start of the instruction
+    if (regOff.Flags & OPERAND_FLAG_VARIABLE) {
+        uint32_t varDecl = ctx.Symbols->get(regOff.Value.Int).VarDecl;
+        uint64_t varAddr = (*ctx.VarDecls)[varDecl].VAddr;
+        uint32_t offset = static_cast<uint32_t>(ctx.Addr - varAddr);
+        out[0] = RO_LAYOUT_IR_INT | RO_LAYOUT_NEGATIVE;
+        out[1] = REG_IP;
+        std::memcpy(&out[2], &offset, 4);
+        return;
+    }
+
+    // Encode RO layout byte
+    out[0] = regOff.Layout;
+
+    // Encode base register
+    out[1] = regOff.Reg;
+    std::memset(&out[2], 0, 4);
+
+    if ((regOff.Layout & RO_LAYOUT_IR_INT) == RO_LAYOUT_IR_INT) {
+        uint32_t immediate = static_cast<uint32_t>(regOff.Value.Int);
+        std::memcpy(&out[2], &immediate, 4);
+    } else if ((regOff.Layout & RO_LAYOUT_IR_IR_INT) == RO_LAYOUT_IR_IR_INT) {
+        out[2] = regOff.OffsetReg;
+        uint16_t immediate = static_cast<uint16_t>(regOff.Value.Int);
+        std::memcpy(&out[3], &immediate, 2);
+    }
+}
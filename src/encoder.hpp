@@ -0,0 +1,216 @@
+// ======================================================================== //
+// Copyright 2021 Michel Fäh
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ======================================================================== //
+
+#pragma once
+#include "ast.hpp"
+#include "symbolTable.hpp"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+struct VarDeclaration;
+
+/** Maximum size of the bytecode of a single instruction */
+constexpr uint32_t MAX_INSTR_SIZE = 15;
+
+/**
+ * How an operand is encoded into the bytecode. Every encoding has a fixed size
+ * so an instruction form with immediates has one encoder per immediate width
+ */
+enum class OperandEncoding : uint8_t {
+    /** Type info which is not encoded */
+    NONE,
+    TYPE,
+    REG,
+    REG_OFFSET,
+    LABEL,
+    I8,
+    I16,
+    I32,
+    I64,
+    F32,
+    F64,
+};
+
+/**
+ * Addresses an encoder needs to resolve the labels and variables an
+ * instruction refers to
+ */
+struct EncodeContext {
+    /** Non owning pointer to the symbol table with the label addresses */
+    const SymbolTable* Symbols = nullptr;
+    /** Non owning pointer to the variable declarations */
+    const std::vector<VarDeclaration>* VarDecls = nullptr;
+    /** Address of the instruction which is encoded */
+    uint64_t Addr = 0;
+};
+
+/**
+ * Writes the bytecode of an instruction
+ * @param instr Instruction record
+ * @param ctx Addresses of the labels and variables
+ * @param out Pointer to the memory which receives the bytecode
+ */
+typedef void (*InstrEncoder)(const InstrRecord& instr,
+                             const EncodeContext& ctx,
+                             uint8_t* out);
+
+/**
+ * Encoder of an instruction form together with the size of the bytecode it
+ * writes
+ */
+struct InstrEncoding {
+    uint8_t Size;
+    InstrEncoder Encode;
+};
+
+void encodeRegisterOffset(const Operand& regOff,
+                          const EncodeContext& ctx,
+                          uint8_t* out);
+
+/**
+ * Returns the size of an encoded operand
+ * @param enc Operand encoding
+ * @return Size in bytes
+ */
+constexpr uint32_t getOperandEncodingSize(OperandEncoding enc) {
+    switch (enc) {
+    case OperandEncoding::NONE:
+        return 0;
+    case OperandEncoding::TYPE:
+    case OperandEncoding::REG:
+    case OperandEncoding::I8:
+        return 1;
+    case OperandEncoding::I16:
+        return 2;
+    case OperandEncoding::I32:
+    case OperandEncoding::F32:
+        return 4;
+    case OperandEncoding::REG_OFFSET:
+        return 6;
+    case OperandEncoding::LABEL:
+    case OperandEncoding::I64:
+    case OperandEncoding::F64:
+        return 8;
+    }
+    return 0;
+}
+
+/**
+ * Returns the size of the bytecode of an instruction form
+ * @tparam Encs Encodings of the operands
+ * @return Size in bytes including the opcode
+ */
+template <OperandEncoding... Encs> constexpr uint32_t getEncodedSize() {
+    return (1 + ... + getOperandEncodingSize(Encs));
+}
+
+/**
+ * Writes a single operand
+ * @tparam Enc Encoding of the operand
+ * @param op Operand
+ * @param ctx Addresses of the labels and variables
+ * @param out Pointer to the memory which receives the operand
+ */
+template <OperandEncoding Enc>
+inline void
+encodeOperand(const Operand& op, const EncodeContext& ctx, uint8_t* out) {
+    if constexpr (Enc == OperandEncoding::TYPE) {
+        out[0] = op.DataType;
+    } else if constexpr (Enc == OperandEncoding::REG) {
+        out[0] = op.Reg;
+    } else if constexpr (Enc == OperandEncoding::REG_OFFSET) {
+        encodeRegisterOffset(op, ctx, out);
+    } else if constexpr (Enc == OperandEncoding::LABEL) {
+        // Every label has its final address since the layout pass
+        uint64_t labelAddr = ctx.Symbols->get(op.Value.Int).LabelAddr;
+        std::memcpy(out, &labelAddr, 8);
+    } else if constexpr (Enc == OperandEncoding::I8) {
+        out[0] = (uint8_t)op.Value.Int;
+    } else if constexpr (Enc == OperandEncoding::I16) {
+        uint16_t typedNum = (uint16_t)op.Value.Int;
+        std::memcpy(out, &typedNum, 2);
+    } else if constexpr (Enc == OperandEncoding::I32) {
+        uint32_t typedNum = (uint32_t)op.Value.Int;
+        std::memcpy(out, &typedNum, 4);
+    } else if constexpr (Enc == OperandEncoding::I64) {
+        std::memcpy(out, &op.Value.Int, 8);
+    } else if constexpr (Enc == OperandEncoding::F32) {
+        float typedNum = (float)op.Value.Float;
+        std::memcpy(out, &typedNum, 4);
+    } else if constexpr (Enc == OperandEncoding::F64) {
+        std::memcpy(out, &op.Value.Float, 8);
+    }
+}
+
+/**
+ * Ends the recursion of encodeOperands() once every operand is written
+ */
+template <uint32_t Index, uint32_t Offset>
+inline void
+encodeOperands(const InstrRecord&, const EncodeContext&, uint8_t*) {}
+
+/**
+ * Writes the operands of an instruction. Every operand is written at an offset
+ * which is known at compile time
+ * @tparam Index Index of the first operand
+ * @tparam Offset Offset of the first operand in the bytecode
+ * @tparam Enc Encoding of the first operand
+ * @tparam Encs Encodings of the remaining operands
+ * @param instr Instruction record
+ * @param ctx Addresses of the labels and variables
+ * @param out Pointer to the bytecode of the instruction
+ */
+template <uint32_t Index,
+          uint32_t Offset,
+          OperandEncoding Enc,
+          OperandEncoding... Encs>
+inline void encodeOperands(const InstrRecord& instr,
+                           const EncodeContext& ctx,
+                           uint8_t* out) {
+    encodeOperand<Enc>(instr.Operands[Index], ctx, &out[Offset]);
+    constexpr uint32_t next = Offset + getOperandEncodingSize(Enc);
+    encodeOperands<Index + 1, next, Encs...>(instr, ctx, out);
+}
+
+/**
+ * Encoder of an instruction form. The encodings and thereby the size and the
+ * operand offsets of the bytecode are fixed at compile time
+ * @tparam Encs Encodings of the operands in order
+ * @param instr Instruction record whose operands match the form
+ * @param ctx Addresses of the labels and variables
+ * @param out Pointer to the memory which receives the bytecode
+ */
+template <OperandEncoding... Encs>
+void encodeInstr(const InstrRecord& instr,
+                 const EncodeContext& ctx,
+                 uint8_t* out) {
+    static_assert(sizeof...(Encs) <= MAX_INSTR_OPERANDS,
+                  "Instruction form has too many operands");
+    static_assert(getEncodedSize<Encs...>() <= MAX_INSTR_SIZE,
+                  "Instruction form exceeds MAX_INSTR_SIZE");
+    out[0] = instr.Opcode;
+    encodeOperands<0, 1, Encs...>(instr, ctx, out);
+}
+
+/**
+ * Creates the table entry of an instruction form encoder
+ * @tparam Encs Encodings of the operands in order
+ * @return Encoder and bytecode size
+ */
+template <OperandEncoding... Encs> constexpr InstrEncoding makeEncoding() {
+    return InstrEncoding{getEncodedSize<Encs...>(), &encodeInstr<Encs...>};
+}
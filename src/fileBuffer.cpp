@@ -15,103 +15,118 @@
 // ======================================================================== //
 
 #include "fileBuffer.hpp"
+#include "fileWrite.hpp"
+#include <algorithm>
+#include <cassert>
 #include <cstring>
 
 /**
- * Constructs a new BufferRange
- * @param Index of buffer
- * @param Size of buffer
+ * Constructs a new OutputFileBuffer
+ * @param chunkSize Size of the memory chunks, must be a power of two
  */
-BufferRange::BufferRange(uint32_t start, size_t size)
-    : Start(start), Size(size),
-      Buffer(std::make_unique<uint8_t[]>(BUFFER_SIZE)) {}
-
-/**
- * Copy constructs a new BufferRange
- */
-BufferRange::BufferRange(BufferRange& buffRange) {
-    this->Start = buffRange.Start;
-    this->Size = buffRange.Size;
-    this->Buffer = std::move(buffRange.Buffer);
-}
-
-/**
- * Move constructs a new BufferRange
- */
-BufferRange::BufferRange(BufferRange&& buffRange) noexcept {
-    this->Start = buffRange.Start;
-    this->Size = buffRange.Size;
-    this->Buffer = std::move(buffRange.Buffer);
+OutputFileBuffer::OutputFileBuffer(uint64_t chunkSize) : ChunkSize(chunkSize) {
+    assert(chunkSize != 0 && (chunkSize & (chunkSize - 1)) == 0);
+    while ((uint64_t(1) << ChunkShift) < chunkSize) {
+        ChunkShift++;
+    }
 }
 
 /**
- * Reserves buffer of size, allocates new buffer range if necessary and
- * increases the internal cursor
- * @param Size to be reserved
+ * Reserves memory at the end of the buffer and increases the internal cursor.
+ * The reserved memory is filled by write()
+ * @param size Size to be reserved
  */
-void OutputFileBuffer::reserve(size_t size) {
-    size_t neededCapacity = Cursor + size;
-    if (neededCapacity > Capacity) {
-        allocBuffer();
-    }
+void OutputFileBuffer::reserve(uint64_t size) {
     Cursor += size;
+    if (Cursor > Capacity) {
+        grow(Cursor);
+    }
 }
 
 /**
- * Writes to already reserved memory. Warning: This only supports blocks up to
- * BUFFER_SIZE
+ * Writes to already reserved memory. Nothing is written for a size of 0, the
+ * index might point behind the last chunk then
  * @param index Destination index
  * @param src Pointer to source
  * @param size Size of memory to be copied
  */
-void OutputFileBuffer::write(size_t index, void* src, size_t size) {
-    // Find buffer with start index
-    BufferRange* range = nullptr;
-    size_t rangeIndex = 0;
-    for (const BufferRange& buff : Buffers) {
-        if (index >= buff.Start && index < buff.Start + buff.Size) {
-            range = const_cast<BufferRange*>(&buff);
-            break;
-        }
-        rangeIndex++;
+void OutputFileBuffer::write(uint64_t index, const void* src, uint64_t size) {
+    assert(index + size <= Cursor);
+    if (size == 0) {
+        return;
     }
 
-    // If data range to be copied is inside single buffer copy data
-    // Convert vAddr to relative offset of buffer array
-    uint64_t offset = index - range->Start;
-    size_t buffEnd = range->Start + range->Size;
-    if (index + size <= buffEnd) {
-        std::memcpy(&range->Buffer[offset], src, size);
-    } else {
-        // If data range overlaps with two buffers perform two memcopys
-        uint64_t sliceOffset = buffEnd - index;
-        std::memcpy(&range->Buffer[offset], src, sliceOffset);
+    const uint8_t* in = static_cast<const uint8_t*>(src);
+    uint64_t chunk = index >> ChunkShift;
+    uint64_t offset = index & (ChunkSize - 1);
 
-        // Get adjacent buffer and copy second data slice
-        BufferRange* adjRange = nullptr;
-        if (Buffers.size() > rangeIndex + 1) {
-            adjRange = &Buffers[rangeIndex + 1];
-        }
+    // Most writes are small and fit into a single chunk
+    if (offset + size <= ChunkSize) {
+        std::memcpy(&Chunks[chunk][offset], in, size);
+        return;
+    }
 
-        uint64_t adjOffset = adjRange->Start - buffEnd;
-        std::memcpy(&adjRange->Buffer[adjOffset],
-                    &static_cast<uint8_t*>(src)[sliceOffset], size - sliceOffset);
+    while (size > 0) {
+        uint64_t sliceSize = std::min(size, ChunkSize - offset);
+        std::memcpy(&Chunks[chunk][offset], in, sliceSize);
+        in += sliceSize;
+        size -= sliceSize;
+        chunk++;
+        offset = 0;
     }
 }
 
+/**
+ * Returns a pointer to already reserved memory if it lies within a single
+ * chunk. The memory can be filled directly through the pointer then
+ * @param index Index of the memory
+ * @param size Size of the memory
+ * @return Pointer to the memory or nullptr if it spans multiple chunks or is
+ * empty
+ */
+uint8_t* OutputFileBuffer::getContiguous(uint64_t index, uint64_t size) {
+    assert(index + size <= Cursor);
+    if (size == 0) {
+        return nullptr;
+    }
+
+    uint64_t offset = index & (ChunkSize - 1);
+    if (offset + size > ChunkSize) {
+        return nullptr;
+    }
+    return &Chunks[index >> ChunkShift][offset];
+}
+
 /**
  * Copy data at the end of the buffer indicated by the internal Cursor
  * @param src Pointer to source
  * @param size Size of memory to be copied
  */
-void OutputFileBuffer::push(void* src, size_t size) {
-    size_t neededCapacity = Cursor + size;
-    if (neededCapacity > Capacity) {
-        allocBuffer();
-    }
+void OutputFileBuffer::push(const void* src, uint64_t size) {
+    uint64_t index = Cursor;
+    reserve(size);
+    write(index, src, size);
+}
 
-    write(Cursor, src, size);
-    Cursor += size;
+/**
+ * Writes the buffer content into a file without copying it. The chunks are
+ * handed to the platform as slices of a single gather write
+ * @param path Path to the file
+ * @return On success returns true, if the platform does not support this or
+ * the write failed returns false
+ */
+bool OutputFileBuffer::writeToFile(const char* path) {
+    std::vector<FileSlice> slices;
+    uint64_t remaining = Cursor;
+    for (const auto& chunk : Chunks) {
+        if (remaining == 0) {
+            break;
+        }
+        uint64_t sliceSize = std::min(remaining, ChunkSize);
+        slices.push_back({chunk.get(), sliceSize});
+        remaining -= sliceSize;
+    }
+    return writeFileSlices(path, slices.data(), slices.size());
 }
 
 /**
@@ -119,19 +134,25 @@ void OutputFileBuffer::push(void* src, size_t size) {
  * @param stream Reference to stream
  */
 void OutputFileBuffer::writeToStream(std::ofstream& stream) {
-    for (auto& range : Buffers) {
-        size_t writeSize = BUFFER_SIZE;
-        if (Cursor < range.Start + range.Size) {
-            writeSize = Cursor - range.Start;
+    uint64_t remaining = Cursor;
+    for (const auto& chunk : Chunks) {
+        if (remaining == 0) {
+            break;
         }
-        stream.write((const char*)(range.Buffer.get()), writeSize);
+        uint64_t writeSize = std::min(remaining, ChunkSize);
+        stream.write((const char*)chunk.get(), writeSize);
+        remaining -= writeSize;
     }
 }
 
 /**
- * Allocates a new buffer and increases the Cursor by the BUFFER_SIZE
+ * Allocates zeroed chunks until the buffer can hold at least the given
+ * capacity
+ * @param capacity Required capacity
  */
-void OutputFileBuffer::allocBuffer() {
-    Buffers.emplace_back(Capacity, BUFFER_SIZE);
-    Capacity += BUFFER_SIZE;
+void OutputFileBuffer::grow(uint64_t capacity) {
+    while (Capacity < capacity) {
+        Chunks.push_back(std::make_unique<uint8_t[]>(ChunkSize));
+        Capacity += ChunkSize;
+    }
 }
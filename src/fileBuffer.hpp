@@ -14,32 +14,40 @@
 // limitations under the License.
 // ======================================================================== //
 
+#pragma once
 #include <cstdint>
 #include <fstream>
 #include <memory>
 #include <vector>
 
-constexpr uint32_t BUFFER_SIZE = 1024;
-
-struct BufferRange {
-    uint64_t Start;
-    size_t Size;
-    std::unique_ptr<uint8_t[]> Buffer;
-    BufferRange(uint32_t start, size_t size);
-    BufferRange(BufferRange& buffRange);
-    BufferRange(BufferRange&& buffRange) noexcept;
-};
+/** Default size of the OutputFileBuffer chunks, it must be a power of two */
+constexpr uint64_t OUTPUT_CHUNK_SIZE = 1024 * 1024;
 
+/**
+ * Growable output buffer which stores the file content in equally sized
+ * chunks. Chunks are never moved, the chunk of an index is found by a shift
+ * and any write can span multiple chunks. Reserved but unwritten bytes are
+ * zero. Disjoint ranges of reserved memory can be written from multiple threads
+ * as long as nothing is reserved meanwhile
+ */
 class OutputFileBuffer {
   public:
-    void reserve(size_t size);
-    void push(void* src, size_t size);
-    void write(size_t index, void* src, size_t size);
+    explicit OutputFileBuffer(uint64_t chunkSize = OUTPUT_CHUNK_SIZE);
+    void reserve(uint64_t size);
+    void push(const void* src, uint64_t size);
+    void write(uint64_t index, const void* src, uint64_t size);
+    uint8_t* getContiguous(uint64_t index, uint64_t size);
+    bool writeToFile(const char* path);
     void writeToStream(std::ofstream& stream);
 
   private:
-    uint32_t Cursor = 0;
-    uint32_t Capacity = 0;
-    std::vector<BufferRange> Buffers;
-    void allocBuffer();
+    /** End of the reserved memory */
+    uint64_t Cursor = 0;
+    /** Size of all allocated chunks */
+    uint64_t Capacity = 0;
+    uint64_t ChunkSize = 0;
+    /** Log2 of the chunk size */
+    uint32_t ChunkShift = 0;
+    std::vector<std::unique_ptr<uint8_t[]>> Chunks;
+    void grow(uint64_t capacity);
 };
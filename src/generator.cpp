@@ -15,9 +15,12 @@
 // ======================================================================== //
 
 #include "generator.hpp"
+#include "asm/encoding.hpp"
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include <fstream>
+#include <thread>
 
 SecNameString::SecNameString(std::string str, vAddr addr)
     : Str(str), Addr(addr) {}
@@ -26,13 +29,18 @@ SecNameString::SecNameString(std::string str, vAddr addr)
  * Constructs a new Generator
  * @param ast Pointer to AST
  * @param p Pointer to output file path
- * @param funcDefs Pointer to array of FuncDefLookup
+ * @param symbols Pointer to the symbol table
+ * @param strings Pointer to the arena of decoded strings
+ * @param threadCount Maximum amount of threads which emit the code section
  */
 Generator::Generator(ASTFileNode* ast,
                      std::filesystem::path* p,
-                     std::vector<LabelDefLookup>* funcDefs,
-                     std::vector<VarDeclaration>* varDecls)
-    : AST(ast), FilePath(p), LabelDefs(funcDefs), VarDecls(varDecls) {}
+                     SymbolTable* symbols,
+                     std::vector<VarDeclaration>* varDecls,
+                     std::vector<uint8_t>* strings,
+                     uint32_t threadCount)
+    : AST(ast), FilePath(p), Symbols(symbols), VarDecls(varDecls),
+      Strings(strings), ThreadCount(threadCount) {}
 
 void Generator::createHeader() {
     // Allocate header
@@ -63,7 +71,14 @@ void Generator::createSectionTable() {
 
     for (const ASTSection* sec : sections) {
         if (sec != nullptr) {
-            if (sec->Body.size() > 0) {
+            // The code section keeps its instructions and labels outside of the
+            // section body
+            bool empty = sec->Body.empty();
+            if (sec->SecType == ASTSectionType::CODE) {
+                empty = AST->Instrs.empty() && AST->Labels.empty();
+            }
+
+            if (!empty) {
                 GenSection secEntry{};
                 char* secName = nullptr;
                 uint8_t secPerms = 0;
@@ -124,128 +139,116 @@ void Generator::createSectionTable() {
 }
 
 void Generator::writeFile() {
+    // Fall back to a stream where gather writes are not supported
+    if (Buffer.writeToFile(FilePath->string().c_str())) {
+        return;
+    }
+
     std::ofstream stream{*FilePath, std::ios::binary};
     Buffer.writeToStream(stream);
     stream.close();
 }
 
-void Generator::emitRegisterOffset(RegisterOffset* regOff, uint8_t* out) {
-    // Check if register offset is variable offset if not resolve it before
-    // encoding
-    if (regOff->Var != nullptr) {
-        resolveVariableOffset(regOff);
+/**
+ * Emits the instructions of a chunk into their reserved range of the file
+ * buffer. The encoders write the bytecode straight into the file buffer unless
+ * an instruction spans two chunks of the buffer. This is run on a worker
+ * thread, the label and variable addresses are only read
+ * @param chunk Chunk of the code section
+ */
+void Generator::emitChunk(const EmitChunk* chunk) {
+    EncodeContext ctx{Symbols, VarDecls, chunk->Addr};
+    for (uint32_t i = chunk->Begin; i < chunk->End; i++) {
+        const InstrRecord& instr = AST->Instrs[i];
+        const InstrEncoding& encoding = Asm::INSTR_ENCODERS[instr.Encoder];
+
+        uint8_t* out = Buffer.getContiguous(ctx.Addr, encoding.Size);
+        if (out != nullptr) {
+            encoding.Encode(instr, ctx, out);
+        } else {
+            uint8_t temp[MAX_INSTR_SIZE] = {};
+            encoding.Encode(instr, ctx, temp);
+            Buffer.write(ctx.Addr, temp, encoding.Size);
+        }
+        ctx.Addr += encoding.Size;
     }
+}
 
-    // Encode RO layout byte
-    out[0] = regOff->Layout;
+/**
+ * Assigns the address of every label before any bytecode is emitted. The size
+ * of every instruction is given by its encoder. Label references can be
+ * encoded right away then. The address of every EMIT_BLOCK_INSTRS-th
+ * instruction is kept to split the code section later
+ * @param startAddr Address of the code section
+ * @return Size of the code section
+ */
+uint64_t Generator::layoutByteCode(uint64_t startAddr) {
+    std::vector<InstrRecord>& instrs = AST->Instrs;
+    std::vector<LabelDef*>& labels = AST->Labels;
+    uint32_t mainId = Symbols->find("main");
+    uint64_t addr = startAddr;
+    BlockAddrs.reserve(instrs.size() / EMIT_BLOCK_INSTRS + 1);
+    // The last iteration only handles the labels behind the last instruction
+    uint32_t labelIndex = 0;
+    for (uint32_t i = 0; i <= instrs.size(); i++) {
+        while (labelIndex < labels.size() &&
+               labels[labelIndex]->InstrIndex == i) {
+            LabelDef* label = labels[labelIndex];
+            labelIndex++;
+
+            // Add label address to the symbol table. This will be used to
+            // encode the label references
+            Symbols->get(label->SymbolId).LabelAddr = addr;
 
-    // Encode base register
-    out[1] = regOff->Base->Id;
+            // If current label is the main label set start address to this
+            if (label->SymbolId == mainId) {
+                StartAddr = addr;
+            }
+        }
 
-    if ((regOff->Layout & RO_LAYOUT_IR_INT) == RO_LAYOUT_IR_INT) {
-        std::memcpy(&out[2], &regOff->Immediate.U16, 4);
-    } else if ((regOff->Layout & RO_LAYOUT_IR_IR_INT) == RO_LAYOUT_IR_IR_INT) {
-        out[2] = regOff->Offset->Id;
-        std::memcpy(&out[3], &regOff->Immediate.U16, 2);
+        if (i < instrs.size()) {
+            if (i % EMIT_BLOCK_INSTRS == 0) {
+                BlockAddrs.push_back(addr);
+            }
+            addr += Asm::INSTR_ENCODERS[instrs[i].Encoder].Size;
+        }
     }
+    return addr - startAddr;
 }
 
 /**
- * Adds a label reference which has to be resolved
- * @param funcRef Non owning pointer to function reference
- * @param vAddr Address to placeholder in output file
+ * Splits the code section into chunks of roughly the same bytecode size. The
+ * chunks start at the instruction blocks of the layout pass
+ * @param startAddr Address of the code section
+ * @param size Size of the code section
+ * @return Chunks in order, there is at least one
  */
-void Generator::addResolvableFuncRef(Identifier* labelRef, uint64_t vAddr) {
-    // Find function definiton which this reference referes to
-    LabelDefLookup* labelDef = nullptr;
-    for (uint32_t i = 0; i < LabelDefs->size(); i++) {
-        LabelDefLookup* lookup = &(*LabelDefs)[i];
-        if (lookup->Def->Name == labelRef->Name) {
-            labelDef = lookup;
+std::vector<EmitChunk> Generator::splitByteCode(uint64_t startAddr,
+                                                uint64_t size) {
+    uint32_t instrCount = AST->Instrs.size();
+    uint64_t chunkCount = std::min<uint64_t>(ThreadCount,
+                                             size / PARALLEL_EMIT_MIN_CHUNK);
+
+    std::vector<EmitChunk> chunks;
+    EmitChunk chunk{0, instrCount, startAddr};
+    for (uint64_t i = 1; i < chunkCount; i++) {
+        // The chunk ends at the first block behind its share of the bytecode
+        uint64_t split = startAddr + size / chunkCount * i;
+        auto block = std::lower_bound(BlockAddrs.begin(), BlockAddrs.end(),
+                                      split);
+        if (block == BlockAddrs.end()) {
             break;
         }
-    }
 
-    // TODO: What if labelDef is not found?
-    ResLabelRefs.push_back(ResolvableLabelRef{vAddr, labelDef});
-}
-
-/**
- * Emits a given instruction
- * @param instr Instruction to emit
- */
-void Generator::emitInstruction(Instruction* instr) {
-    constexpr uint32_t MAX_INSTR_SIZE = 15;
-    // Temporary instruction mem
-    uint8_t temp[MAX_INSTR_SIZE] = {0};
-    uint32_t instrSize = 0;
-
-    // Set opcode
-    temp[0] = instr->Opcode;
-    instrSize++;
-
-    // Emits parameters
-    for (auto& param : instr->Params) {
-        switch (param->Type) {
-        case ASTType::IDENTIFIER: {
-            Identifier* id = dynamic_cast<Identifier*>(param);
-            addResolvableFuncRef(id, Cursor + instrSize);
-            instrSize += 8;
-        } break;
-        case ASTType::FLOAT_NUMBER: {
-            ASTFloat* num = dynamic_cast<ASTFloat*>(param);
-            if (num->DataType == UVM_TYPE_F32) {
-                float typedNum = (float)num->Num;
-                std::memcpy(&temp[instrSize], &typedNum, 4);
-                instrSize += 4;
-            } else if (num->DataType == UVM_TYPE_F64) {
-                std::memcpy(&temp[instrSize], &num->Num, 8);
-                instrSize += 8;
-            }
-        } break;
-        case ASTType::INTEGER_NUMBER: {
-            ASTInt* num = dynamic_cast<ASTInt*>(param);
-            if (num->DataType == UVM_TYPE_I8) {
-                uint8_t typedNum = (uint8_t)num->Num;
-                temp[instrSize] = typedNum;
-                instrSize++;
-            } else if (num->DataType == UVM_TYPE_I16) {
-                uint16_t typedNum = (uint16_t)num->Num;
-                std::memcpy(&temp[instrSize], &typedNum, 2);
-                instrSize += 2;
-            } else if (num->DataType == UVM_TYPE_I32) {
-                uint32_t typedNum = (uint32_t)num->Num;
-                std::memcpy(&temp[instrSize], &typedNum, 4);
-                instrSize += 4;
-            } else if (num->DataType == UVM_TYPE_I64) {
-                std::memcpy(&temp[instrSize], &num->Num, 8);
-                instrSize += 8;
-            }
-        } break;
-        case ASTType::REGISTER_ID: {
-            RegisterId* reg = dynamic_cast<RegisterId*>(param);
-            temp[instrSize] = reg->Id;
-            instrSize++;
-        } break;
-        case ASTType::REGISTER_OFFSET: {
-            RegisterOffset* regOff = dynamic_cast<RegisterOffset*>(param);
-            emitRegisterOffset(regOff, &temp[instrSize]);
-            instrSize += 6;
-        } break;
-        case ASTType::TYPE_INFO: {
-            TypeInfo* typeInfo = dynamic_cast<TypeInfo*>(param);
-            if (instr->EncodingFlags & INSTR_FLAG_ENCODE_TYPE) {
-                temp[instrSize] = typeInfo->DataType;
-                instrSize++;
-            }
-        } break;
+        uint32_t begin = (block - BlockAddrs.begin()) * EMIT_BLOCK_INSTRS;
+        if (begin > chunk.Begin) {
+            chunk.End = begin;
+            chunks.push_back(chunk);
+            chunk = EmitChunk{begin, instrCount, *block};
         }
     }
-
-    // Copy temp instr bytecode to file buffer
-    Buffer.reserve(instrSize);
-    Buffer.write(Cursor, temp, instrSize);
-    Cursor += instrSize;
+    chunks.push_back(chunk);
+    return chunks;
 }
 
 /**
@@ -260,51 +263,25 @@ void Generator::createByteCode() {
         }
     }
 
-    // Set the current Cursor as start of code section
+    // Set the current Cursor as start of code section. Once all addresses are
+    // known the code section is reserved and every chunk of it is emitted
+    // into its own range
     codeSec->StartAddr = Cursor;
-    for (auto& globElem : AST->SecCode->Body) {
-        switch (globElem->Type) {
-        case ASTType::LABEL_DEFINITION: {
-            LabelDef* label = dynamic_cast<LabelDef*>(globElem);
-
-            // Find label definiton in lookup table
-            LabelDefLookup* lookup = nullptr;
-            for (uint32_t i = 0; i < LabelDefs->size(); i++) {
-                if ((*LabelDefs)[i].Def->Name == label->Name) {
-                    lookup = &(*LabelDefs)[i];
-                    break;
-                }
-            }
-
-            // Add label definition address to lookup table. This will be used
-            // to fill in the placeholders addresses of label calls. This
-            // assumes that the function def exists in the lookup table
-            lookup->VAddr = Cursor;
-
-            // If current label is the main label set start address to this
-            if (label->Name == "main") {
-                StartAddr = Cursor;
-            }
-        } break;
-        case ASTType::INSTRUCTION: {
-            Instruction* instr = dynamic_cast<Instruction*>(globElem);
-            emitInstruction(instr);
-        }
-        }
+    uint64_t codeSize = layoutByteCode(Cursor);
+    codeSec->Size = codeSize;
+    Buffer.reserve(codeSize);
+    std::vector<EmitChunk> chunks = splitByteCode(Cursor, codeSize);
+
+    // Emit the first chunk on this thread and all others on worker threads
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < chunks.size(); i++) {
+        workers.emplace_back(&Generator::emitChunk, this, &chunks[i]);
     }
-
-    // Set code section size
-    codeSec->Size = Cursor - codeSec->StartAddr;
-}
-
-/**
- * Resolves all label references and fills in the placeholder addresses
- */
-void Generator::resolveLabelRefs() {
-    for (const ResolvableLabelRef& res : ResLabelRefs) {
-        uint64_t labelVAddr = res.LabelDef->VAddr;
-        Buffer.write(res.VAddr, &labelVAddr, sizeof(labelVAddr));
+    emitChunk(&chunks[0]);
+    for (std::thread& worker : workers) {
+        worker.join();
     }
+    Cursor += codeSize;
 }
 
 void Generator::fillSectionTable() {
@@ -337,47 +314,46 @@ void Generator::encodeSectionVars(GenSection& sec) {
     uint64_t secStartAddr = Cursor;
 
     for (ASTNode* node : sec.SecPtr->Body) {
-        ASTVariable* var = dynamic_cast<ASTVariable*>(node);
+        ASTVariable* var = nodeCast<ASTVariable>(node);
         uint8_t varType = var->DataType->DataType;
         uint32_t varSize = 0;
 
         switch (varType) {
         case UVM_TYPE_I8: {
-            ASTInt* astInt = dynamic_cast<ASTInt*>(var->Val);
+            ASTInt* astInt = nodeCast<ASTInt>(var->Val);
             Buffer.push((uint8_t*)&astInt->Num, 1);
             varSize = 1;
         } break;
         case UVM_TYPE_I16: {
-            ASTInt* astInt = dynamic_cast<ASTInt*>(var->Val);
+            ASTInt* astInt = nodeCast<ASTInt>(var->Val);
             Buffer.push((uint8_t*)&astInt->Num, 2);
             varSize = 2;
         } break;
         case UVM_TYPE_I32: {
-            ASTInt* astInt = dynamic_cast<ASTInt*>(var->Val);
+            ASTInt* astInt = nodeCast<ASTInt>(var->Val);
             Buffer.push((uint8_t*)&astInt->Num, 4);
             varSize = 4;
         } break;
         case UVM_TYPE_I64: {
-            ASTInt* astInt = dynamic_cast<ASTInt*>(var->Val);
+            ASTInt* astInt = nodeCast<ASTInt>(var->Val);
             Buffer.push((uint8_t*)&astInt->Num, 8);
             varSize = 8;
         } break;
         case UVM_TYPE_F32: {
-            ASTFloat* astFloat = dynamic_cast<ASTFloat*>(var->Val);
+            ASTFloat* astFloat = nodeCast<ASTFloat>(var->Val);
             float val = static_cast<float>(astFloat->Num);
             Buffer.push((uint8_t*)&val, 4);
             varSize = 4;
         } break;
         case UVM_TYPE_F64: {
-            ASTFloat* astFloat = dynamic_cast<ASTFloat*>(var->Val);
+            ASTFloat* astFloat = nodeCast<ASTFloat>(var->Val);
             Buffer.push((uint8_t*)&astFloat->Num, 8);
             varSize = 8;
         } break;
         case BASS_TYPE_STRING: {
-            ASTString* str = dynamic_cast<ASTString*>(var->Val);
-            uint32_t strSize = str->Val.size();
-            Buffer.push(str->Val.data(), strSize);
-            varSize = strSize;
+            ASTString* str = nodeCast<ASTString>(var->Val);
+            Buffer.push(&Strings->data()[str->ArenaIndex], str->Length);
+            varSize = str->Length;
         } break;
         }
 
@@ -389,23 +365,6 @@ void Generator::encodeSectionVars(GenSection& sec) {
     sec.StartAddr = secStartAddr;
 }
 
-/**
- * Fills out variable offset with register offset
- */
-void Generator::resolveVariableOffset(RegisterOffset* ro) {
-    constexpr uint8_t REG_IP = 0x1;
-
-    ro->Layout = RO_LAYOUT_IR_INT | RO_LAYOUT_NEGATIVE;
-    ro->Base = new RegisterId(0, 0, 0, 0, REG_IP);
-    // Find variable definiton
-    for (auto& varDecl : *VarDecls) {
-        if (varDecl.Id->Name == ro->Var->Name) {
-            ro->Immediate.U32 = static_cast<uint32_t>(Cursor - varDecl.VAddr);
-            break;
-        }
-    }
-}
-
 /**
  * Generates the output UX file and writes it to disk
  */
@@ -421,7 +380,6 @@ void Generator::genBinary() {
     }
 
     createByteCode();
-    resolveLabelRefs();
 
     Buffer.write(0x8, (uint8_t*)&StartAddr, 8);
     fillSectionTable();
@@ -16,6 +16,7 @@
 
 #pragma once
 #include "ast.hpp"
+#include "encoder.hpp"
 #include "fileBuffer.hpp"
 #include "parser.hpp"
 #include <cstdint>
@@ -32,21 +33,16 @@ constexpr uint8_t SEC_CODE = 0x6;
 constexpr uint32_t HEADER_SIZE = 0x60;
 constexpr uint32_t SEC_TABLE_ENTRY_SIZE = 0x16;
 
-// TODO: Remove?
-typedef unsigned long long vAddr;
-
+/** Amount of instructions between two addresses kept by the layout pass */
+constexpr uint32_t EMIT_BLOCK_INSTRS = 1024;
 /**
- * This is used to track which label definitons have been refered to by
- * bytecode. When the bytecode is beeing generated label pointers will be
- * filled with placeholders (null pointers) and are resolved once the location
- * of every label is known by the generator.
+ * Minimum size of a chunk of the code section which is emitted on its own
+ * thread
  */
-struct ResolvableLabelRef {
-    /** Virtual address to placeholder address */
-    uint64_t VAddr = 0;
-    /** Non owning pointer to LabelDefLookup which this LabelDef resolves to */
-    LabelDefLookup* LabelDef = nullptr;
-};
+constexpr uint64_t PARALLEL_EMIT_MIN_CHUNK = 1024 * 1024;
+
+// TODO: Remove?
+typedef unsigned long long vAddr;
 
 struct SecNameString {
     SecNameString(std::string str, vAddr addr);
@@ -63,12 +59,26 @@ struct GenSection {
     ASTSection* SecPtr = nullptr;
 };
 
+/**
+ * Range of the code section which is emitted on its own thread
+ */
+struct EmitChunk {
+    /** Index of the first instruction */
+    uint32_t Begin = 0;
+    /** Index behind the last instruction */
+    uint32_t End = 0;
+    /** Address of the first instruction */
+    uint64_t Addr = 0;
+};
+
 class Generator {
   public:
     Generator(ASTFileNode* ast,
               std::filesystem::path* p,
-              std::vector<LabelDefLookup>* funcDefs,
-              std::vector<VarDeclaration>* varDecls);
+              SymbolTable* symbols,
+              std::vector<VarDeclaration>* varDecls,
+              std::vector<uint8_t>* strings,
+              uint32_t threadCount);
     void genBinary();
 
   private:
@@ -76,26 +86,28 @@ class Generator {
     ASTFileNode* AST = nullptr;
     /** Non owning pointer to source file */
     std::filesystem::path* FilePath = nullptr;
-    /** Non owning pointer to function defintions created by parser stage */
-    std::vector<LabelDefLookup>* LabelDefs = nullptr;
-    /** Vector of label references which have to be resolved */
-    std::vector<ResolvableLabelRef> ResLabelRefs;
+    /** Non owning pointer to the symbol table created by parser stage */
+    SymbolTable* Symbols = nullptr;
     /** Non owning pointer */
     std::vector<VarDeclaration>* VarDecls;
+    /** Non owning pointer to the arena of decoded strings */
+    std::vector<uint8_t>* Strings = nullptr;
+    /** Maximum amount of threads which emit the code section */
+    uint32_t ThreadCount = 1;
     OutputFileBuffer Buffer;
     std::vector<GenSection> Sections;
     std::vector<SecNameString> SecNameStrings;
     uint64_t Cursor = 0;
     vAddr StartAddr = 0;
+    /** Address of every EMIT_BLOCK_INSTRS-th instruction */
+    std::vector<uint64_t> BlockAddrs;
     void createHeader();
     void createSectionTable();
-    void addResolvableFuncRef(Identifier* funcRef, uint64_t vAddr);
-    void emitRegisterOffset(RegisterOffset* regOff, uint8_t* tempBuff);
-    void emitInstruction(Instruction* instr);
+    void emitChunk(const EmitChunk* chunk);
+    uint64_t layoutByteCode(uint64_t startAddr);
+    std::vector<EmitChunk> splitByteCode(uint64_t startAddr, uint64_t size);
     void createByteCode();
-    void resolveLabelRefs();
     void fillSectionTable();
     void writeFile();
     void encodeSectionVars(GenSection& sec);
-    void resolveVariableOffset(RegisterOffset* ro);
 };
@@ -0,0 +1,275 @@
+// ======================================================================== //
+// Copyright 2021 Michel Fäh
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ======================================================================== //
+
+
+#include "literal.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+/** Powers of ten which multiply a number to make room for a chunk of digits */
+static constexpr uint64_t POWERS_OF_TEN[] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+
+/** Maximum amount of significant digits of a 64-bit decimal integer */
+constexpr uint32_t MAX_DEC_DIGITS = 20;
+/** Maximum amount of significant digits of a 64-bit hexadecimal integer */
+constexpr uint32_t MAX_HEX_DIGITS = 16;
+
+/** Every integer up to 2^53 is exactly representable as a double */
+constexpr uint64_t MAX_EXACT_FLOAT_INT = uint64_t(1) << 53;
+/**
+ * Longer float number strings have more digits than the fast path can decode
+ * exactly unless they have many leading zeros
+ */
+constexpr int32_t MAX_FAST_FLOAT_SIZE = 17;
+/** Float exponents are capped at this value while they are decoded */
+constexpr int32_t MAX_FLOAT_EXPONENT = 100000;
+/** Every power of ten up to 10^22 is exactly representable as a double */
+constexpr int32_t MAX_EXACT_POWER_OF_TEN = 22;
+static constexpr double EXACT_POWERS_OF_TEN[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+/**
+ * Loads 8 chars into an integer so that the first char is in the lowest byte
+ * @param c Pointer to the first char
+ * @return Loaded chars
+ */
+static uint64_t loadChunk(const uint8_t* c) {
+    uint64_t chunk = 0;
+    std::memcpy(&chunk, c, sizeof(chunk));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    chunk = __builtin_bswap64(chunk);
+#endif
+    return chunk;
+}
+
+/**
+ * Loads up to 8 digits as a chunk which is padded with leading zeros. Up to 7
+ * chars behind the digits are read as well but ignored
+ * @param c Pointer to the first digit
+ * @param count Amount of digits between 1 and 8
+ * @param zero Value of the zero digit in every byte
+ * @return Loaded digits
+ */
+static uint64_t loadDigits(const uint8_t* c, uint32_t count, uint64_t zero) {
+    // Shifting the first char up moves the chars behind the digits out and
+    // inserts leading zeros
+    return (loadChunk(c) - zero) << (8 * (8 - count));
+}
+
+/**
+ * Converts 8 decimal digits in parallel
+ * @param chunk 8 digits with the values 0-9, the first digit in the lowest byte
+ * @return Value of the digits
+ */
+static uint64_t convertDecChunk(uint64_t chunk) {
+    // Combine neighbouring digits, then pairs and then quadruples of digits
+    chunk = (chunk * 10 + (chunk >> 8)) & 0x00FF00FF00FF00FF;
+    chunk = (chunk * 100 + (chunk >> 16)) & 0x0000FFFF0000FFFF;
+    return (chunk * 10000 + (chunk >> 32)) & 0xFFFFFFFF;
+}
+
+/**
+ * Converts 8 hexadecimal digits in parallel
+ * @param chunk 8 chars [0-9a-fA-F], the first char in the lowest byte
+ * @return Value of the digits
+ */
+static uint64_t convertHexChunk(uint64_t chunk) {
+    // The low nibble of [0-9] is their value and the low nibble of [a-fA-F] is
+    // their value minus 9. Only the letters have bit 6 set
+    uint64_t letters = (chunk >> 6) & 0x0101010101010101;
+    chunk = (chunk & 0x0F0F0F0F0F0F0F0F) + letters * 9;
+
+    // Combine neighbouring nibbles, then pairs and then quadruples of nibbles
+    chunk = ((chunk << 4) + (chunk >> 8)) & 0x00FF00FF00FF00FF;
+    chunk = ((chunk << 8) + (chunk >> 16)) & 0x0000FFFF0000FFFF;
+    return ((chunk << 16) + (chunk >> 32)) & 0xFFFFFFFF;
+}
+
+/**
+ * Decodes a decimal or hexadecimal (0x prefixed) integer. The digits are
+ * converted 8 at a time and might be read up to 7 chars past the end
+ * @param begin Pointer to the first char of the number string
+ * @param end Pointer behind the last char of the number string
+ * @param num [out] Decoded integer
+ * @return If integer fits into a 64-bit integer returns true otherwise false
+ */
+bool decodeInt(const uint8_t* begin, const uint8_t* end, uint64_t& num) {
+    num = 0;
+
+    if (end - begin > 2 && begin[0] == '0' && begin[1] == 'x') {
+        const uint8_t* c = &begin[2];
+        while (c < end && *c == '0') {
+            c++;
+        }
+
+        // Only leading zeros can be shifted out without changing the value
+        uint32_t count = end - c;
+        if (count > MAX_HEX_DIGITS) {
+            return false;
+        }
+
+        // Convert the first count % 8 digits and then full chunks of 8
+        uint32_t chunkSize = ((count - 1) % 8) + 1;
+        while (c < end) {
+            uint64_t chunk = loadDigits(c, chunkSize, 0);
+            num = (num << (4 * chunkSize)) | convertHexChunk(chunk);
+            c += chunkSize;
+            chunkSize = 8;
+        }
+        return true;
+    }
+
+    const uint8_t* c = begin;
+    while (c < end && *c == '0') {
+        c++;
+    }
+
+    // Most numbers fit into a single chunk
+    uint32_t count = end - c;
+    if (count <= 8) {
+        if (count != 0) {
+            num = convertDecChunk(loadDigits(c, count, 0x3030303030303030));
+        }
+        return true;
+    }
+
+    if (count > MAX_DEC_DIGITS) {
+        return false;
+    }
+
+    // Every number with up to 19 digits fits, the 20th digit is added
+    // separately with an overflow check
+    const uint8_t* last = end;
+    if (count == MAX_DEC_DIGITS) {
+        last--;
+        count--;
+    }
+
+    uint32_t chunkSize = ((count - 1) % 8) + 1;
+    while (c < last) {
+        uint64_t chunk = loadDigits(c, chunkSize, 0x3030303030303030);
+        num = num * POWERS_OF_TEN[chunkSize] + convertDecChunk(chunk);
+        c += chunkSize;
+        chunkSize = 8;
+    }
+
+    if (last != end) {
+        uint64_t digit = *last - '0';
+        if (num > (UINT64_MAX - digit) / 10) {
+            return false;
+        }
+        num = num * 10 + digit;
+    }
+    return true;
+}
+
+/**
+ * Decodes a floating-point number whose digits form an integer up to
+ * MAX_EXACT_FLOAT_INT and whose power of ten is exactly representable. The
+ * digits and the power of ten are both exact doubles and a single
+ * multiplication or division rounds correctly then
+ * @param begin Pointer to the first char of the number string
+ * @param end Pointer behind the last char of the number string
+ * @param num [out] Decoded floating-point number
+ * @return If the number could be decoded this way returns true otherwise false
+ */
+static bool decodeFloatFast(const uint8_t* begin,
+                            const uint8_t* end,
+                            double& num) {
+    const uint8_t* c = begin;
+    uint64_t digits = 0;
+    int32_t exponent = 0;
+
+    // Collect the digits in front of and behind the point and give up as soon
+    // as they are not exact anymore
+    for (; c < end && (uint8_t)(*c - '0') <= 9; c++) {
+        digits = digits * 10 + (*c - '0');
+        if (digits > MAX_EXACT_FLOAT_INT) {
+            return false;
+        }
+    }
+    if (c < end && *c == '.') {
+        const uint8_t* fraction = ++c;
+        for (; c < end && (uint8_t)(*c - '0') <= 9; c++) {
+            digits = digits * 10 + (*c - '0');
+            if (digits > MAX_EXACT_FLOAT_INT) {
+                return false;
+            }
+        }
+        exponent = fraction - c;
+    }
+
+    if (c < end && (*c == 'e' || *c == 'E')) {
+        c++;
+        bool negative = false;
+        if (c < end && (*c == '+' || *c == '-')) {
+            negative = *c == '-';
+            c++;
+        }
+
+        // Such large exponents never take this path, they are capped to avoid
+        // an overflow
+        int32_t power = 0;
+        const uint8_t* powerStart = c;
+        for (; c < end && (uint8_t)(*c - '0') <= 9; c++) {
+            power = std::min(power * 10 + (*c - '0'), MAX_FLOAT_EXPONENT);
+        }
+        if (c == powerStart) {
+            return false;
+        }
+        exponent += negative ? -power : power;
+    }
+
+    // Numbers with trailing chars which are not part of the number are left to
+    // the slow path
+    if (c != end || exponent < -MAX_EXACT_POWER_OF_TEN ||
+        exponent > MAX_EXACT_POWER_OF_TEN) {
+        return false;
+    }
+
+    num = (double)digits;
+    if (exponent < 0) {
+        num /= EXACT_POWERS_OF_TEN[-exponent];
+    } else {
+        num *= EXACT_POWERS_OF_TEN[exponent];
+    }
+    return true;
+}
+
+/**
+ * Decodes a floating-point number. Like std::stod only the longest prefix which
+ * forms a valid number is decoded, this makes "1.5e" equal to "1.5". Most
+ * numbers are decoded by a fast path, all others are correctly rounded by
+ * std::from_chars
+ * @param begin Pointer to the first char of the number string
+ * @param end Pointer behind the last char of the number string
+ * @param num [out] Decoded floating-point number
+ * @return If the number fits into a 64-bit float returns true otherwise false
+ */
+bool decodeFloat(const uint8_t* begin, const uint8_t* end, double& num) {
+    bool fast = end - begin <= MAX_FAST_FLOAT_SIZE;
+    if (fast && decodeFloatFast(begin, end, num)) {
+        return true;
+    }
+
+    num = 0;
+    std::from_chars_result res =
+        std::from_chars((const char*)begin, (const char*)end, num);
+    return res.ec == std::errc{};
+}
@@ -0,0 +1,26 @@
+// ======================================================================== //
+// Copyright 2021 Michel Fäh
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ======================================================================== //
+
+
+#pragma once
+#include <cstdint>
+
+// These functions decode the number literals found by the scanner. They expect
+// the number string to be validated by the scanner already and read up to 7
+// chars past its end, which the SOURCE_PADDING of the source file allows.
+
+bool decodeInt(const uint8_t* begin, const uint8_t* end, uint64_t& num);
+bool decodeFloat(const uint8_t* begin, const uint8_t* end, double& num);
@@ -17,6 +17,7 @@
 #include "asm/asm.hpp"
 #include "assembler.hpp"
 #include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <vector>
 
@@ -24,24 +25,32 @@
  * Prints usage information
  */
 void printUsage() {
-    std::cout << "usage: bass <source-file> [output-file]\n";
+    std::cout << "usage: bass [--parallel-scan] <source-file> [output-file]\n";
 }
 
 int main(int argc, char* argv[]) {
+    // Separate the options from the positional arguments
+    bool parallelScan = false;
+    std::vector<char*> args;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--parallel-scan") == 0) {
+            parallelScan = true;
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+
     char* outputDirArg = nullptr;
-    if (argc < 2) {
+    if (args.empty()) {
         printUsage();
         return -1;
-    } else if (argc == 3) {
-        outputDirArg = argv[2];
+    } else if (args.size() == 2) {
+        outputDirArg = args[1];
     }
 
-    // Build data structure used to type check instruction parameters
-    std::vector<InstrDefNode> instrDefs;
-    buildInstrDefTree(instrDefs);
-
     // Create new assembler
-    Assembler asmler{&instrDefs, argv[1]};
+    Assembler asmler{args[0]};
+    asmler.setParallelScan(parallelScan);
 
     if (!asmler.setOutputDir(outputDirArg)) {
         std::cout << "[ERROR] Output directory '" << outputDirArg
@@ -51,7 +60,7 @@ int main(int argc, char* argv[]) {
 
     bool fileReadSucc = asmler.readSource();
     if (!fileReadSucc) {
-        std::cout << "[ERROR] Could not read source file '" << argv[1] << "'\n";
+        std::cout << "[ERROR] Could not read source file '" << args[0] << "'\n";
         return -1;
     }
 
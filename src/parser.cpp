@@ -17,8 +17,9 @@
 #include "parser.hpp"
 #include "asm/asm.hpp"
 #include "asm/encoding.hpp"
+#include "byteSearch.hpp"
 #include "cli.hpp"
-#include <cfloat>
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
@@ -73,127 +74,184 @@ bool checkIntWidth(uint64_t num, uint8_t type, bool isSigned) {
 }
 
 /**
- * Checks if a float can fit into given type assmuning that type is less than
- * 64-bit
- * @param num Integer to be checked
+ * Checks if a float can fit into given type. The scanner already checked the
+ * width while decoding the float
+ * @param exceedsF32 Is set if the float does not fit into 32 bits
  * @param type Target type
  * @return On success returns true otherwise false
  */
-bool checkFloatWidth(double num, uint8_t type) {
+bool checkFloatWidth(bool exceedsF32, uint8_t type) {
     bool fits = false;
     switch (type) {
     case UVM_TYPE_F32:
-        if (num <= FLT_MAX) {
-            fits = true;
-        }
+        fits = !exceedsF32;
         break;
     case UVM_TYPE_F64:
-        if (num <= DBL_MAX) {
-            fits = true;
-        }
+        fits = true;
         break;
     }
     return fits;
 }
 
 /**
- * Converts a string to an integer
- * @param str String to be converted
- * @param num [out] Converted integer
- * @return If integer fits into a 64-bit integer returns true otherwhise false
+ * Returns the kind of an instruction operand. Type infos of types which no
+ * parameter accepts are invalid
+ * @param op Instruction operand
+ * @return Operand kind
  */
-bool strToInt(std::string& str, uint64_t& num) {
-    int32_t base = 10;
-    if (str.size() >= 3) {
-        if (str[0] == '0' && str[1] == 'x') {
-            base = 16;
+static OperandKind getOperandKind(const Operand& op) {
+    switch (op.Type) {
+    case OperandType::TYPE_INFO:
+        if (op.DataType == UVM_TYPE_I8 || op.DataType == UVM_TYPE_I16 ||
+            op.DataType == UVM_TYPE_I32 || op.DataType == UVM_TYPE_I64) {
+            return OperandKind::INT_TYPE;
+        }
+        if (op.DataType == UVM_TYPE_F32 || op.DataType == UVM_TYPE_F64) {
+            return OperandKind::FLOAT_TYPE;
+        }
+        return OperandKind::INVALID;
+    case OperandType::REGISTER_ID:
+        if (getRegisterType(op.Reg) == RegisterType::INTEGER) {
+            return OperandKind::INT_REG;
         }
+        return OperandKind::FLOAT_REG;
+    case OperandType::REGISTER_OFFSET:
+        return OperandKind::REG_OFFSET;
+    case OperandType::INTEGER_NUMBER:
+        return OperandKind::INT_NUM;
+    case OperandType::FLOAT_NUMBER:
+        return OperandKind::FLOAT_NUM;
+    case OperandType::IDENTIFIER:
+        return OperandKind::LABEL;
     }
-    // Warning: this only works with unsigned numbers and  does not handle
-    // signed numbers
-    // If string number is bigger than 64-bit exception is thrown.
-    try {
-        num = std::stoull(str, 0, base);
-    } catch (const std::out_of_range) {
-        return false;
+    return OperandKind::INVALID;
+}
+
+/**
+ * Finds the parameter list which accepts the operands of an instruction. The
+ * operands are classified into a packed signature which selects the parameter
+ * list with a single lookup
+ * @param instr Instruction record
+ * @return Pointer to the parameter list or nullptr if no list matches
+ */
+static const InstrParamList* matchInstrParams(const InstrRecord& instr) {
+    // Surplus operands are not stored in the record and no parameter list
+    // accepts them
+    if (instr.OperandCount > MAX_INSTR_OPERANDS) {
+        return nullptr;
     }
-    return true;
+
+    uint32_t kinds = 0;
+    for (uint32_t i = 0; i < instr.OperandCount; i++) {
+        OperandKind kind = getOperandKind(instr.Operands[i]);
+        kinds = packOperandKind(kinds, kind, i);
+    }
+    return findInstrSignature(instr.ASMDefIndex, kinds);
 }
 
 /**
- * Converts a string to a floating-point value
- * @param str String to be converted
- * @param num [out] Converted float
- * @return If a floating-point value fits into a 64-bit float returns true
- * otherwhise false
+ * Returns the encoder of an instruction. The encoders of a form with an
+ * immediate follow each other in the order of the data types
+ * @param paramList Parameter list which accepts the operands
+ * @param type Type info operand of the instruction or nullptr if it has none
+ * @return Index of the encoder in Asm::INSTR_ENCODERS
  */
-bool strToFP(std::string& str, double& num) {
-    try {
-        num = std::stod(str, nullptr);
-    } catch (const std::out_of_range& e) {
-        return false;
-    } catch (const std::invalid_argument& e) {
-        return false;
+static uint8_t getInstrEncoder(const InstrParamList* paramList,
+                               const Operand* type) {
+    for (uint32_t i = 0; i < paramList->ParamCount; i++) {
+        switch (paramList->Params[i]) {
+        case InstrParamType::INT_NUM:
+            return paramList->Encoder + (type->DataType - UVM_TYPE_I8);
+        case InstrParamType::FLOAT_NUM:
+            return paramList->Encoder + (type->DataType - UVM_TYPE_F32);
+        default:
+            break;
+        }
     }
-    return true;
+    return paramList->Encoder;
+}
+
+/**
+ * Attaches the opcode and the encoding information of a parameter list
+ * @param instr Instruction record
+ * @param paramList Parameter list which accepts the operands
+ * @param type Type info operand of the instruction or nullptr if it has none
+ */
+static void attachEncoding(InstrRecord& instr,
+                           const InstrParamList* paramList,
+                           const Operand* type) {
+    // Check if the opcode is determined by a type variant
+    if (paramList->Flags & INSTR_FLAG_TYPE_VARIANTS) {
+        uint8_t opcode = 0;
+        // Find opcode variant
+        for (uint32_t i = 0; i < paramList->VariantCount; i++) {
+            const TypeVariant* variant = &paramList->OpcodeVariants[i];
+            if (variant->Type == type->DataType) {
+                opcode = variant->Opcode;
+            }
+        }
+        instr.Opcode = opcode;
+    } else {
+        instr.Opcode = paramList->Opcode;
+    }
+    instr.EncodingFlags = paramList->Flags;
+    instr.Encoder = getInstrEncoder(paramList, type);
+}
+
+/**
+ * Creates the reference of an operand to a label or variable
+ * @param op Identifier or variable register offset operand
+ * @param instrIndex Index of the instruction record
+ * @return Symbol reference
+ */
+static SymbolRef makeSymbolRef(const Operand& op, uint32_t instrIndex) {
+    return SymbolRef{(uint32_t)op.Value.Int, instrIndex, op.Index, op.Size};
 }
 
 /**
  * Constructs a new Parser
- * @param instrDefs Pointer to instruction definitons
  * @param src Pointer to the source file
- * @param tokens Pointer to the token array
+ * @param scan Pointer to the scanner which hands out the tokens
  * @param global [out] Pointer to the Global AST node
- * @param funcDefs [out] Pointer to the FuncDefLookup
+ * @param symbols [out] Pointer to the symbol table
+ * @param strings [out] Pointer to the arena which receives decoded strings
+ * @param nodes [out] Pointer to the arena which owns the created AST nodes
  */
-Parser::Parser(std::vector<InstrDefNode>* instrDefs,
-               SourceFile* src,
-               const std::vector<Token>* tokens,
+Parser::Parser(SourceFile* src,
+               Scanner* scan,
                ASTFileNode* fileNode,
-               std::vector<LabelDefLookup>* funcDefs,
-               std::vector<VarDeclaration>* varDecls)
-    : InstrDefs(instrDefs), Src(src), Tokens(tokens), FileNode(fileNode),
-      LabelDefs(funcDefs), VarDecls(varDecls){};
+               SymbolTable* symbols,
+               std::vector<VarDeclaration>* varDecls,
+               std::vector<uint8_t>* strings,
+               ASTArena* nodes)
+    : Src(src), Scan(scan), FileNode(fileNode),
+      Symbols(symbols), VarDecls(varDecls), Strings(strings),
+      Nodes(nodes){};
 
 /**
- * Returns token at current Cursor and increases the Cursor
- * @return Pointer to current Token, if Cursor is at the end will always return
- * the last token
+ * Returns the next token and consumes it
+ * @return Current Token, if the scanner is at the end will always return the
+ * end of file token
  */
-Token* Parser::eatToken() {
-    const Token* tok = nullptr;
-    if (Cursor < Tokens->size()) {
-        // Because Cursor starts at index 0 return current token before
-        // increasing the cursor
-        tok = &(*Tokens)[Cursor];
-        Cursor++;
-    } else {
-        tok = &Tokens->back();
-    }
-    return const_cast<Token*>(tok);
+Token Parser::eatToken() {
+    return Scan->next();
 }
 
 /**
- * Return the next Token without increasing the Cursor
- * @return Pointer to current Token, if Cursor is at the end will always return
- * the last token
+ * Return the next Token without consuming it
+ * @return Current Token, if the scanner is at the end will always return the
+ * end of file token
  */
-Token* Parser::peekToken() {
-    const Token* tok = nullptr;
-    if (Cursor >= Tokens->size()) {
-        tok = &Tokens->back();
-    } else {
-        tok = &(*Tokens)[Cursor];
-    }
-    return const_cast<Token*>(tok);
+Token Parser::peekToken() {
+    return Scan->peek();
 }
 
 /**
  * Skips token input until new line
  */
 void Parser::skipLine() {
-    Token* tok = eatToken();
-    while (tok->Type != TokenType::END_OF_FILE && tok->Type != TokenType::EOL) {
+    Token tok = eatToken();
+    while (tok.Type != TokenType::END_OF_FILE && tok.Type != TokenType::EOL) {
         tok = eatToken();
     }
 }
@@ -203,143 +261,136 @@ void Parser::skipLine() {
  * @param msg Pointer to error message string
  * @param tok Token to be displayed
  */
-void Parser::printTokenError(const char* msg, Token& tok) {
-    printError(Src, tok.Index, tok.Size, tok.LineRow, tok.LineCol, msg);
+void Parser::printTokenError(const char* msg, const Token& tok) {
+    // Diagnostics of the scanner are printed first. If the scanner failed the
+    // token stream is incomplete and the parser diagnostic is meaningless
+    if (!Scan->finishSource()) {
+        return;
+    }
+    printError(Src, tok.Index, tok.Size, msg);
 }
 
 /**
  * Parses a string and replaces escaped characters and removes surrounding
- * quotes
- * @param inStr String containing the input
- * @param outStr [out] String containing the parsed output
+ * quotes. The runs of chars between the escape sequences are copied to the
+ * string arena at once
+ * @param inStr View of the string token including the quotes
  */
 // TODO: RETURN ERROR VALUE
-void Parser::parseStringEscape(std::string& inStr, std::string& outStr) {
-    // If string only consists of "" (two double quotes) string is empty so just
-    // return
-    if (inStr.size() == 2) {
-        return;
-    }
+void Parser::parseStringEscape(std::string_view inStr) {
+    // Skip the first quote and ignore the end quote
+    const uint8_t* c = (const uint8_t*)&inStr[1];
+    const uint8_t* end = (const uint8_t*)&inStr[inStr.size() - 1];
+
+    while (c < end) {
+        const uint8_t* escape = findByte(c, end, '\\');
+        Strings->insert(Strings->end(), c, escape);
+        if (escape == end) {
+            return;
+        }
 
-    // Cursor starts at 1 to skip the first quote and size - 1 in loop to ignore
-    // end quote
-    size_t cursor = 1;
-    while (cursor < inStr.size() - 1) {
-        char c = inStr[cursor];
-        char p = inStr[cursor + 1];
-
-        if (c == '\\') {
-            switch (p) {
-            case 't':
-                c = 0x09;
-                break;
-            case 'v':
-                c = 0x0B;
-                break;
-            case '0':
-                c = 0x00;
-                break;
-            case 'b':
-                c = 0x08;
-                break;
-            case 'f':
-                c = 0x0C;
-                break;
-            case 'n':
-                c = 0x0A;
-                break;
-            case 'r':
-                c = 0x0D;
-                break;
-            case '"':
-                c = 0x22;
-                break;
-            case '\\':
-                c = 0x5C;
-                break;
-            default:
-                return;
-                break;
-            }
-            cursor++;
+        uint8_t decoded = 0;
+        switch (escape[1]) {
+        case 't':
+            decoded = 0x09;
+            break;
+        case 'v':
+            decoded = 0x0B;
+            break;
+        case '0':
+            decoded = 0x00;
+            break;
+        case 'b':
+            decoded = 0x08;
+            break;
+        case 'f':
+            decoded = 0x0C;
+            break;
+        case 'n':
+            decoded = 0x0A;
+            break;
+        case 'r':
+            decoded = 0x0D;
+            break;
+        case '"':
+            decoded = 0x22;
+            break;
+        case '\\':
+            decoded = 0x5C;
+            break;
+        default:
+            return;
+            break;
         }
 
-        outStr.push_back(c);
-        cursor++;
+        Strings->push_back(decoded);
+        c = &escape[2];
     }
 }
 
 /**
- * Parses a register offset and appends it to the parent instruction node
- * @param instr Pointer to parent instruction node
+ * Parses a register offset operand
+ * @param regOff [out] Register offset operand
  * @return On valid register offset returns true otherwise false
  */
-bool Parser::parseRegOffset(Instruction* instr) {
+bool Parser::parseRegOffset(Operand& regOff) {
     constexpr uint8_t RO_LAYOUT_NEG = 0b1000'0000;
     constexpr uint8_t RO_LAYOUT_POS = 0b0000'0000;
-    RegisterOffset* regOff = new RegisterOffset();
-    Token* t = eatToken();
+    regOff.Type = OperandType::REGISTER_OFFSET;
+    Token t = eatToken();
 
     // Check if register offset is a variable offset e.g "[staticVar]"
-    if (t->Type == TokenType::IDENTIFIER) {
-        std::string idString;
-        Src->getSubStr(t->Index, t->Size, idString);
-        regOff->Var =
-            new Identifier(t->Index, t->Size, t->LineRow, t->LineCol, idString);
+    if (t.Type == TokenType::IDENTIFIER) {
+        regOff.Flags = OPERAND_FLAG_VARIABLE;
+        regOff.Index = t.Index;
+        regOff.Size = t.Size;
+        regOff.Value.Int = Symbols->intern(Src->getView(t.Index, t.Size));
 
         t = eatToken();
         // Closing bracket
-        if (t->Type != TokenType::RIGHT_SQUARE_BRACKET) {
+        if (t.Type != TokenType::RIGHT_SQUARE_BRACKET) {
             printTokenError(
-                "Expected closing bracket ] after variable reference", *t);
+                "Expected closing bracket ] after variable reference", t);
             return false;
         }
-        instr->Params.push_back(regOff);
         return true;
     }
 
-    if (t->Type == TokenType::REGISTER_DEFINITION) {
-        if (getRegisterType(t->Tag) != RegisterType::INTEGER) {
-            printTokenError("Expected integer register as base", *t);
+    if (t.Type == TokenType::REGISTER_DEFINITION) {
+        if (getRegisterType(t.Tag) != RegisterType::INTEGER) {
+            printTokenError("Expected integer register as base", t);
             return false;
         }
-        regOff->Base =
-            new RegisterId(t->Index, t->Size, t->LineRow, t->LineCol, t->Tag);
+        regOff.Reg = t.Tag;
         t = eatToken();
     } else {
-        printTokenError("Expected register in register offset", *t);
+        printTokenError("Expected register in register offset", t);
         return false;
     }
 
-    if (t->Type == TokenType::RIGHT_SQUARE_BRACKET) {
-        regOff->Index = t->Index;
-        regOff->LineRow = t->LineRow;
-        regOff->LineCol = t->LineCol;
-        regOff->Layout = RO_LAYOUT_IR;
-        instr->Params.push_back(regOff);
+    if (t.Type == TokenType::RIGHT_SQUARE_BRACKET) {
+        regOff.Index = t.Index;
+        regOff.Layout = RO_LAYOUT_IR;
         return true;
-    } else if (t->Type == TokenType::PLUS_SIGN) {
-        regOff->Layout |= RO_LAYOUT_POS;
-    } else if (t->Type == TokenType::MINUS_SIGN) {
-        regOff->Layout |= RO_LAYOUT_NEG;
+    } else if (t.Type == TokenType::PLUS_SIGN) {
+        regOff.Layout |= RO_LAYOUT_POS;
+    } else if (t.Type == TokenType::MINUS_SIGN) {
+        regOff.Layout |= RO_LAYOUT_NEG;
     } else {
-        printTokenError("Unexpected token in register offset", *t);
+        printTokenError("Unexpected token in register offset", t);
         return false;
     }
 
     t = eatToken();
     // <iR> +/- <i32>
-    if (t->Type == TokenType::INTEGER_NUMBER) {
-        Token* peek = peekToken();
-        if (peek != nullptr && peek->Type == TokenType::RIGHT_SQUARE_BRACKET) {
-            // Get int string and convert to an int
-            std::string numStr;
-            Src->getSubStr(t->Index, t->Size, numStr);
-            uint64_t num = 0;
-            if (!strToInt(numStr, num)) {
+    if (t.Type == TokenType::INTEGER_NUMBER) {
+        Token peek = peekToken();
+        if (peek.Type == TokenType::RIGHT_SQUARE_BRACKET) {
+            uint64_t num = t.Value.Int;
+            if (t.Tag == TAG_LITERAL_OUT_OF_RANGE) {
                 printTokenError(
                     "Register offset immediate does not fit into 32-bit value",
-                    *t);
+                    t);
                 return false;
             }
 
@@ -348,47 +399,47 @@ bool Parser::parseRegOffset(Instruction* instr) {
             if (num >> 32 != 0) {
                 printTokenError(
                     "Register offset immediate does not fit into 32-bit value",
-                    *t);
+                    t);
                 return false;
             }
-            regOff->Immediate.U32 = (uint32_t)num;
+            regOff.Value.Int = num;
 
             // TODO: Register offset position is not correct
-            regOff->Index = t->Index;
-            regOff->LineRow = t->LineRow;
-            regOff->LineCol = t->LineCol;
-            regOff->Layout |= RO_LAYOUT_IR_INT;
-            instr->Params.push_back(regOff);
+            regOff.Index = t.Index;
+            regOff.Layout |= RO_LAYOUT_IR_INT;
             t = eatToken();
         } else {
             printTokenError(
                 "Expected closing bracket after immediate offset inside "
                 "register offset ]",
-                *t);
+                t);
             return false;
         }
-    } else if (t->Type == TokenType::REGISTER_DEFINITION) {
-        if (getRegisterType(t->Tag) != RegisterType::INTEGER) {
-            printTokenError("Expected integer register as offset", *t);
+    } else if (t.Type == TokenType::REGISTER_DEFINITION) {
+        if (getRegisterType(t.Tag) != RegisterType::INTEGER) {
+            printTokenError("Expected integer register as offset", t);
             return false;
         }
-        regOff->Offset =
-            new RegisterId(t->Index, t->Size, t->LineRow, t->LineCol, t->Tag);
+        regOff.OffsetReg = t.Tag;
         t = eatToken();
-        if (t->Type == TokenType::ASTERISK) {
+        if (t.Type == TokenType::ASTERISK) {
             t = eatToken();
         } else {
             printTokenError("Expected * after offset inside register offset",
-                            *t);
+                            t);
+            return false;
+        }
+
+        if (t.Type != TokenType::INTEGER_NUMBER) {
+            printTokenError(
+                "Expected integer factor after * inside register offset", t);
             return false;
         }
 
-        std::string numStr;
-        Src->getSubStr(t->Index, t->Size, numStr);
-        uint64_t num = 0;
-        if (!strToInt(numStr, num)) {
+        uint64_t num = t.Value.Int;
+        if (t.Tag == TAG_LITERAL_OUT_OF_RANGE) {
             printTokenError(
-                "Register offset immediate does not fit into 16-bit value", *t);
+                "Register offset immediate does not fit into 16-bit value", t);
             return false;
         }
 
@@ -396,26 +447,23 @@ bool Parser::parseRegOffset(Instruction* instr) {
         // bits Check if the requirement is meet otherwise throw error
         if (num >> 16 != 0) {
             printTokenError(
-                "Register offset immediate does not fit into 16-bit value", *t);
+                "Register offset immediate does not fit into 16-bit value", t);
             return false;
         }
-        regOff->Immediate.U16 = (uint16_t)num;
+        regOff.Value.Int = num;
         t = eatToken();
 
-        if (t->Type == TokenType::RIGHT_SQUARE_BRACKET) {
+        if (t.Type == TokenType::RIGHT_SQUARE_BRACKET) {
             // TODO: Register offset position is not correct
-            regOff->Index = t->Index;
-            regOff->LineRow = t->LineRow;
-            regOff->LineCol = t->LineCol;
-            regOff->Layout |= RO_LAYOUT_IR_IR_INT;
-            instr->Params.push_back(regOff);
+            regOff.Index = t.Index;
+            regOff.Layout |= RO_LAYOUT_IR_IR_INT;
         } else {
-            printTokenError("Expectd closing bracket after factor", *t);
+            printTokenError("Expectd closing bracket after factor", t);
             return false;
         }
 
     } else {
-        printTokenError("Expected register or int number as offset", *t);
+        printTokenError("Expected register or int number as offset", t);
         return false;
     }
     return true;
@@ -428,161 +476,168 @@ bool Parser::parseRegOffset(Instruction* instr) {
  */
 bool Parser::parseSectionVars(ASTSection* sec) {
     bool validSec = true;
-    Token* tok = eatToken();
+    Token tok = eatToken();
 
     // Ignore end of line
-    if (tok->Type == TokenType::EOL) {
+    if (tok.Type == TokenType::EOL) {
         tok = eatToken();
     }
 
-    while (tok->Type != TokenType::RIGHT_CURLY_BRACKET) {
+    while (tok.Type != TokenType::RIGHT_CURLY_BRACKET) {
         Identifier* id = nullptr;
         TypeInfo* typeInfo = nullptr;
         ASTNode* val = nullptr;
 
         // Variable name
-        if (tok->Type != TokenType::IDENTIFIER) {
-            printTokenError("Expected static variable identifier", *tok);
+        if (tok.Type != TokenType::IDENTIFIER) {
+            printTokenError("Expected static variable identifier", tok);
             validSec = false;
             break;
         }
 
-        std::string idName;
-        Src->getSubStr(tok->Index, tok->Size, idName);
-        id = new Identifier(tok->Index, tok->Size, tok->LineRow, tok->LineCol,
-                            idName);
+        uint32_t symbolId = Symbols->intern(Src->getView(tok.Index, tok.Size));
+        id = Nodes->create<Identifier>(tok.Index, tok.Size, symbolId);
 
         // Colon
         tok = eatToken();
-        if (tok->Type != TokenType::COLON) {
-            printTokenError("Expected colon after variable identifier", *tok);
+        if (tok.Type != TokenType::COLON) {
+            printTokenError("Expected colon after variable identifier", tok);
             validSec = false;
             break;
         }
 
         // Type
         tok = eatToken();
-        if (tok->Type != TokenType::TYPE_INFO) {
-            printTokenError("Expected type info in variable declaration", *tok);
+        if (tok.Type != TokenType::TYPE_INFO) {
+            printTokenError("Expected type info in variable declaration", tok);
             validSec = false;
             break;
         }
-        typeInfo = new TypeInfo(tok->Index, tok->Size, tok->LineRow,
-                                tok->LineCol, tok->Tag);
+        typeInfo = Nodes->create<TypeInfo>(tok.Index, tok.Size, tok.Tag);
 
         // Equals
         tok = eatToken();
-        if (tok->Type != TokenType::EQUALS_SIGN) {
+        if (tok.Type != TokenType::EQUALS_SIGN) {
             printTokenError(
                 "Expected equals sign after type info in variable declaration",
-                *tok);
+                tok);
             validSec = false;
             break;
         }
         tok = eatToken();
 
-        Token* signToken = nullptr;
-        char signTokenText = '\0';
-        if (tok->Type == TokenType::PLUS_SIGN ||
-            tok->Type == TokenType::MINUS_SIGN) {
+        Token signToken;
+        bool hasSign = false;
+        if (tok.Type == TokenType::PLUS_SIGN ||
+            tok.Type == TokenType::MINUS_SIGN) {
             signToken = tok;
-            Src->getChar(signToken->Index, signTokenText);
+            hasSign = true;
             tok = eatToken();
         }
 
-        std::string tokString;
-        Src->getSubStr(tok->Index, tok->Size, tokString);
+        if (tok.Type == TokenType::STRING) {
+            if (typeInfo->DataType != BASS_TYPE_STRING) {
+                printTokenError("String does not fit into given type value",
+                                tok);
+                validSec = false;
+                break;
+            }
 
-        if (tok->Type == TokenType::STRING) {
-            std::string parsedStr;
-            parseStringEscape(tokString, parsedStr);
-            ASTString* str = new ASTString(tok->Index, tok->Size, tok->LineRow,
-                                           tok->LineCol, parsedStr);
-            val = dynamic_cast<ASTNode*>(str);
-        } else if (tok->Type == TokenType::INTEGER_NUMBER) {
+            uint32_t arenaIndex = Strings->size();
+            parseStringEscape(Src->getView(tok.Index, tok.Size));
+            uint32_t length = Strings->size() - arenaIndex;
+            ASTString* str =
+                Nodes->create<ASTString>(tok.Index, tok.Size, arenaIndex,
+                                         length);
+            val = str;
+        } else if (tok.Type == TokenType::INTEGER_NUMBER) {
+            uint64_t intVal = tok.Value.Int;
             bool isSigned = false;
             // Check if sign token +/- is followed immediately by number. If so
-            // insert +/- into token string to convert it to an number
-            if (signToken != nullptr) {
-                if (signToken->Index + 1 == tok->Index) {
-                    tokString.insert(0, 1, signTokenText);
-                    if (signToken->Type == TokenType::MINUS_SIGN) {
+            // apply the sign to the number
+            if (hasSign) {
+                if (signToken.Index + 1 == tok.Index) {
+                    if (signToken.Type == TokenType::MINUS_SIGN) {
+                        intVal = 0 - intVal;
                         isSigned = true;
                     }
                 } else {
-                    printTokenError("Unexpected operator", *signToken);
+                    printTokenError("Unexpected operator", signToken);
                     validSec = false;
                     break;
                 }
             }
 
-            uint64_t intVal = 0;
-            if (!strToInt(tokString, intVal)) {
-                printTokenError("Integer does not fit into 64-bit value", *tok);
+            if (tok.Tag == TAG_LITERAL_OUT_OF_RANGE) {
+                printTokenError("Integer does not fit into 64-bit value", tok);
                 validSec = false;
                 break;
             }
 
             if (!checkIntWidth(intVal, typeInfo->DataType, isSigned)) {
                 printTokenError("Integer does not fit into given type value",
-                                *tok);
+                                tok);
                 validSec = false;
                 break;
             }
 
-            ASTInt* integer = new ASTInt(tok->Index, tok->Size, tok->LineRow,
-                                         tok->LineCol, intVal, isSigned);
-            val = dynamic_cast<ASTNode*>(integer);
-        } else if (tok->Type == TokenType::FLOAT_NUMBER) {
+            ASTInt* integer =
+                Nodes->create<ASTInt>(tok.Index, tok.Size, intVal, isSigned);
+            val = integer;
+        } else if (tok.Type == TokenType::FLOAT_NUMBER) {
+            double floatVal = tok.Value.Float;
             // Check if sign token +/- is followed immediately by number. If so
-            // insert +/- into token string to convert it to an number
-            if (signToken != nullptr) {
-                if (signToken->Index + 1 == tok->Index) {
-                    tokString.insert(0, 1, signTokenText);
+            // apply the sign to the number
+            if (hasSign) {
+                if (signToken.Index + 1 == tok.Index) {
+                    if (signToken.Type == TokenType::MINUS_SIGN) {
+                        floatVal = -floatVal;
+                    }
                 } else {
-                    printTokenError("Unexpected operator", *signToken);
+                    printTokenError("Unexpected operator", signToken);
                     validSec = false;
                     break;
                 }
             }
 
-            double floatVal = 0;
-            if (!strToFP(tokString, floatVal)) {
+            if (tok.Tag == TAG_LITERAL_OUT_OF_RANGE) {
                 printTokenError(
                     "Floating-point value does not fit into 64-bit value",
-                    *tok);
+                    tok);
                 validSec = false;
                 break;
             }
 
-            if (!checkFloatWidth(floatVal, typeInfo->DataType)) {
+            bool exceedsF32 = tok.Tag == TAG_LITERAL_EXCEEDS_F32;
+            if (!checkFloatWidth(exceedsF32, typeInfo->DataType)) {
                 printTokenError(
-                    "Floating-point value does not fit into given value", *tok);
+                    "Floating-point value does not fit into given value", tok);
                 validSec = false;
                 break;
             }
 
-            ASTFloat* fl = new ASTFloat(tok->Index, tok->Size, tok->LineRow,
-                                        tok->LineCol, floatVal);
-            val = dynamic_cast<ASTNode*>(fl);
+            ASTFloat* fl =
+                Nodes->create<ASTFloat>(tok.Index, tok.Size, floatVal,
+                                        exceedsF32);
+            val = fl;
         } else {
             printTokenError(
-                "Expected string, float or integer as variable value", *tok);
+                "Expected string, float or integer as variable value", tok);
             validSec = false;
             break;
         }
 
         tok = eatToken();
-        if (tok->Type != TokenType::EOL) {
+        if (tok.Type != TokenType::EOL) {
             printTokenError("Expected new line after variable declaration",
-                            *tok);
+                            tok);
             validSec = false;
             break;
         }
 
         uint32_t varSize = (val->Index + val->Size) - id->Index;
-        sec->Body.push_back(new ASTVariable(id->Index, varSize, id->LineRow,
-                                            id->LineCol, id, typeInfo, val));
+        sec->Body.push_back(
+            Nodes->create<ASTVariable>(id->Index, varSize, id, typeInfo, val));
         tok = eatToken();
     }
 
@@ -595,192 +650,201 @@ bool Parser::parseSectionVars(ASTSection* sec) {
  */
 bool Parser::parseSectionCode() {
     ParseState state = ParseState::GLOBAL_SCOPE;
-    // Pointer to currently parsed function or instruction
-    Instruction* instr = nullptr;
+    std::vector<InstrRecord>& instrs = FileNode->Instrs;
+    // Index of the currently parsed instruction record
+    uint32_t instrIndex = 0;
 
     while (state != ParseState::END) {
-        Token* t = eatToken();
+        Token t = eatToken();
         switch (state) {
         case ParseState::GLOBAL_SCOPE: {
             // Skip new line token
-            if (t->Type == TokenType::EOL) {
+            if (t.Type == TokenType::EOL) {
                 t = eatToken();
             }
 
-            if (t->Type == TokenType::END_OF_FILE ||
-                t->Type == TokenType::RIGHT_CURLY_BRACKET) {
+            if (t.Type == TokenType::END_OF_FILE ||
+                t.Type == TokenType::RIGHT_CURLY_BRACKET) {
                 state = ParseState::END;
                 continue;
             }
 
-            switch (t->Type) {
+            switch (t.Type) {
             case TokenType::INSTRUCTION: {
-                std::string instrName;
-                Src->getSubStr(t->Index, t->Size, instrName);
-                instr = new Instruction(t->Index, t->Size, t->LineRow,
-                                        t->LineCol, instrName, t->Tag);
-                FileNode->SecCode->Body.push_back(instr);
-
-                Token* peek = peekToken();
-                if (peek->Type == TokenType::END_OF_FILE) {
+                instrIndex = instrs.size();
+                InstrRecord& instr = instrs.emplace_back();
+                instr.Index = t.Index;
+                instr.Size = t.Size;
+                instr.ASMDefIndex = t.Tag;
+
+                Token peek = peekToken();
+                if (peek.Type == TokenType::END_OF_FILE) {
                     printTokenError("Unexpected end of file after instruction",
-                                    *t);
+                                    t);
                     return false;
                 }
 
-                if (peek->Type != TokenType::EOL) {
+                if (peek.Type != TokenType::EOL) {
                     state = ParseState::INSTR_BODY;
+                } else {
+                    resolveInstrParams(instrIndex);
                 }
             } break;
             case TokenType::LABEL_DEF: {
-                std::string labelName;
                 // + 1 because @ sign at start of label should be ignored
-                Src->getSubStr(t->Index + 1, t->Size - 1, labelName);
-                LabelDef* label = new LabelDef(t->Index, t->Size, t->LineRow,
-                                               t->LineCol, labelName);
-                FileNode->SecCode->Body.push_back(label);
-
-                Token* peek = peekToken();
-                if (peek->Type != TokenType::EOL) {
+                std::string_view labelName =
+                    Src->getView(t.Index + 1, t.Size - 1);
+                LabelDef* label = Nodes->create<LabelDef>(
+                    t.Index, t.Size, Symbols->intern(labelName), instrs.size());
+                FileNode->Labels.push_back(label);
+
+                Token peek = peekToken();
+                if (peek.Type != TokenType::EOL) {
                     printTokenError("Expected new line after label definition",
-                                    *t);
+                                    t);
                     return false;
                 }
                 t = eatToken(); // TODO: BUG ?
             } break;
             default:
-                printTokenError("Unexpected token in function body", *t);
+                printTokenError("Unexpected token in function body", t);
                 return false;
                 break;
             }
         } break;
         case ParseState::INSTR_BODY: {
+            InstrRecord& instr = instrs[instrIndex];
             bool endOfParamList = false;
 
-            if (t->Type == TokenType::TYPE_INFO) {
-                TypeInfo* typeInfo = new TypeInfo(t->Index, t->Size, t->LineRow,
-                                                  t->LineCol, t->Tag);
-                instr->Params.push_back(typeInfo);
+            if (t.Type == TokenType::TYPE_INFO) {
+                Operand& typeInfo = instr.Operands[instr.OperandCount++];
+                typeInfo.Type = OperandType::TYPE_INFO;
+                typeInfo.DataType = t.Tag;
+                typeInfo.Index = t.Index;
+                typeInfo.Size = t.Size;
                 t = eatToken();
 
                 // This prevents the parser from trying to parse the instruction
                 // body of instruction which only have a type a parameter like
                 // "pop i8"
-                if (t->Type == TokenType::EOL) {
+                if (t.Type == TokenType::EOL) {
                     endOfParamList = true;
                 }
             }
 
             while (!endOfParamList) {
-                Token* signToken = nullptr;
-                char signTokenText = '\0';
-                if (t->Type == TokenType::PLUS_SIGN ||
-                    t->Type == TokenType::MINUS_SIGN) {
+                Token signToken;
+                bool hasSign = false;
+                if (t.Type == TokenType::PLUS_SIGN ||
+                    t.Type == TokenType::MINUS_SIGN) {
                     signToken = t;
-                    Src->getChar(signToken->Index, signTokenText);
+                    hasSign = true;
                     t = eatToken();
                 }
 
                 // Sign token must be followed by an integer or float number in
                 // the code section otherwise print an error
-                if (signToken != nullptr &&
-                    (t->Type != TokenType::INTEGER_NUMBER &&
-                     t->Type != TokenType::FLOAT_NUMBER)) {
-                    printTokenError("Unexpected operator", *signToken);
+                if (hasSign && (t.Type != TokenType::INTEGER_NUMBER &&
+                                t.Type != TokenType::FLOAT_NUMBER)) {
+                    printTokenError("Unexpected operator", signToken);
                     return false;
                 }
 
-                switch (t->Type) {
+                Operand param{};
+                param.Index = t.Index;
+                param.Size = t.Size;
+                switch (t.Type) {
                 case TokenType::IDENTIFIER: {
-                    std::string idName;
-                    Src->getSubStr(t->Index, t->Size, idName);
-                    Identifier* id = new Identifier(
-                        t->Index, t->Size, t->LineRow, t->LineCol, idName);
-                    instr->Params.push_back(id);
+                    std::string_view idName = Src->getView(t.Index, t.Size);
+                    param.Type = OperandType::IDENTIFIER;
+                    param.Value.Int = Symbols->intern(idName);
                 } break;
                 case TokenType::REGISTER_DEFINITION: {
-                    RegisterId* reg = new RegisterId(
-                        t->Index, t->Size, t->LineRow, t->LineCol, t->Tag);
-                    instr->Params.push_back(reg);
+                    param.Type = OperandType::REGISTER_ID;
+                    param.Reg = t.Tag;
                 } break;
                 case TokenType::LEFT_SQUARE_BRACKET: {
-                    bool validRO = parseRegOffset(instr);
+                    bool validRO = parseRegOffset(param);
                     if (!validRO) {
                         return false;
                     }
+                    if (param.Flags & OPERAND_FLAG_VARIABLE) {
+                        VarRefs.push_back(makeSymbolRef(param, instrIndex));
+                    }
                 } break;
                 case TokenType::INTEGER_NUMBER: {
-                    std::string numStr;
-                    Src->getSubStr(t->Index, t->Size, numStr);
-
-                    bool isSigned = false;
+                    uint64_t num = t.Value.Int;
                     // Check if sign token +/- is followed immediately by
-                    // number. If so insert +/- into token string to convert it
-                    // to an number
-                    if (signToken != nullptr) {
-                        if (signToken->Index + 1 == t->Index) {
-                            numStr.insert(0, 1, signTokenText);
-                            if (signToken->Type == TokenType::MINUS_SIGN) {
-                                isSigned = true;
+                    // number. If so apply the sign to the number
+                    if (hasSign) {
+                        if (signToken.Index + 1 == t.Index) {
+                            if (signToken.Type == TokenType::MINUS_SIGN) {
+                                num = 0 - num;
+                                param.Flags = OPERAND_FLAG_SIGNED;
                             }
                         } else {
-                            printTokenError("Unexpected operator", *signToken);
+                            printTokenError("Unexpected operator", signToken);
                             return false;
                         }
                     }
 
-                    uint64_t num = 0;
-
-                    if (!strToInt(numStr, num)) {
+                    if (t.Tag == TAG_LITERAL_OUT_OF_RANGE) {
                         printTokenError(
-                            "Integer does not fit into 64-bit value", *t);
+                            "Integer does not fit into 64-bit value", t);
                         return false;
                     }
 
-                    ASTInt* iNum = new ASTInt(t->Index, t->Size, t->LineRow,
-                                              t->LineCol, num, isSigned);
-                    instr->Params.push_back(iNum);
+                    param.Type = OperandType::INTEGER_NUMBER;
+                    param.Value.Int = num;
                 } break;
                 case TokenType::FLOAT_NUMBER: {
-                    std::string floatStr;
-                    Src->getSubStr(t->Index, t->Size, floatStr);
-
+                    double num = t.Value.Float;
                     // Check if sign token +/- is followed immediately by
-                    // number. If so insert +/- into token string to convert it
-                    // to an number
-                    if (signToken != nullptr) {
-                        if (signToken->Index + 1 == t->Index) {
-                            floatStr.insert(0, 1, signTokenText);
+                    // number. If so apply the sign to the number
+                    if (hasSign) {
+                        if (signToken.Index + 1 == t.Index) {
+                            if (signToken.Type == TokenType::MINUS_SIGN) {
+                                num = -num;
+                            }
                         } else {
-                            printTokenError("Unexpected operator", *signToken);
+                            printTokenError("Unexpected operator", signToken);
                             return false;
                         }
                     }
 
-                    double num = 0;
-                    if (!strToFP(floatStr, num)) {
+                    if (t.Tag == TAG_LITERAL_OUT_OF_RANGE) {
                         printTokenError("Float does not fit into 64-bit value",
-                                        *t);
+                                        t);
                         return false;
                     }
 
-                    ASTFloat* iNum = new ASTFloat(t->Index, t->Size, t->LineRow,
-                                                  t->LineCol, num);
-                    instr->Params.push_back(iNum);
+                    param.Type = OperandType::FLOAT_NUMBER;
+                    if (t.Tag == TAG_LITERAL_EXCEEDS_F32) {
+                        param.Flags = OPERAND_FLAG_EXCEEDS_F32;
+                    }
+                    param.Value.Float = num;
                 } break;
                 default:
-                    printTokenError("Expected parameter", *t);
+                    printTokenError("Expected parameter", t);
                     return false;
                     break;
                 }
+
+                if (instr.OperandCount < MAX_INSTR_OPERANDS) {
+                    instr.Operands[instr.OperandCount] = param;
+                    instr.OperandCount++;
+                } else {
+                    instr.OperandCount = MAX_INSTR_OPERANDS + 1;
+                }
                 t = eatToken();
 
-                if (t->Type == TokenType::COMMA) {
+                if (t.Type == TokenType::COMMA) {
                     t = eatToken();
-                } else if (t->Type == TokenType::EOL) {
+                } else if (t.Type == TokenType::EOL) {
                     endOfParamList = true;
                 }
             }
+            resolveInstrParams(instrIndex);
             state = ParseState::GLOBAL_SCOPE;
         } break;
         }
@@ -794,79 +858,76 @@ bool Parser::parseSectionCode() {
  */
 bool Parser::buildAST() {
     bool validInput = true;
-    Token* currentToken = eatToken();
-    while (currentToken->Type != TokenType::END_OF_FILE) {
+    Token currentToken = eatToken();
+    while (currentToken.Type != TokenType::END_OF_FILE) {
         // Ignore EOL
-        if (currentToken->Type == TokenType::EOL) {
+        if (currentToken.Type == TokenType::EOL) {
             currentToken = eatToken();
             continue;
         }
 
         // Section identifier
-        if (currentToken->Type != TokenType::IDENTIFIER) {
+        if (currentToken.Type != TokenType::IDENTIFIER) {
             printTokenError("Expected section identifier in global scope",
-                            *currentToken);
+                            currentToken);
             validInput = false;
             break;
         }
-        Token* secToken = currentToken;
+        Token secToken = currentToken;
 
         // identifer {
         currentToken = eatToken();
-        if (currentToken->Type != TokenType::LEFT_CURLY_BRACKET) {
+        if (currentToken.Type != TokenType::LEFT_CURLY_BRACKET) {
             printTokenError("Expected { after section identifier",
-                            *currentToken);
+                            currentToken);
             validInput = false;
             break;
         }
 
-        std::string secName;
-        Src->getSubStr(secToken->Index, secToken->Size, secName);
+        std::string_view secName =
+            Src->getView(secToken.Index, secToken.Size);
 
         if (secName == "static") {
             if (FileNode->SecStatic != nullptr) {
-                printTokenError("Section 'static' already defined", *secToken);
+                printTokenError("Section 'static' already defined", secToken);
                 validInput = false;
                 break;
             }
 
-            FileNode->SecStatic = new ASTSection(
-                secToken->Index, secToken->Size, secToken->LineRow,
-                secToken->LineCol, secName, ASTSectionType::STATIC);
+            FileNode->SecStatic = Nodes->create<ASTSection>(
+                secToken.Index, secToken.Size, secName, ASTSectionType::STATIC);
             if (!parseSectionVars(FileNode->SecStatic)) {
                 validInput = false;
                 break;
             }
         } else if (secName == "global") {
             if (FileNode->SecGlobal != nullptr) {
-                printTokenError("Section 'global' already defined", *secToken);
+                printTokenError("Section 'global' already defined", secToken);
                 validInput = false;
                 break;
             }
 
-            FileNode->SecGlobal = new ASTSection(
-                secToken->Index, secToken->Size, secToken->LineRow,
-                secToken->LineCol, secName, ASTSectionType::GLOBAL);
+            FileNode->SecGlobal = Nodes->create<ASTSection>(
+                secToken.Index, secToken.Size, secName, ASTSectionType::GLOBAL);
             if (!parseSectionVars(FileNode->SecGlobal)) {
                 validInput = false;
                 break;
             }
         } else if (secName == "code") {
             if (FileNode->SecCode != nullptr) {
-                printTokenError("Section 'code' already defined", *secToken);
+                printTokenError("Section 'code' already defined", secToken);
                 validInput = false;
                 break;
             }
 
-            FileNode->SecCode = new ASTSection(
-                secToken->Index, secToken->Size, secToken->LineRow,
-                secToken->LineCol, secName, ASTSectionType::CODE);
+            FileNode->SecCode = Nodes->create<ASTSection>(
+                secToken.Index, secToken.Size, secName, ASTSectionType::CODE);
             if (!parseSectionCode()) {
                 validInput = false;
                 break;
             }
         } else {
-            printTokenError("Unknown section type", *secToken);
+            printTokenError("Unknown section type", secToken);
             validInput = false;
             break;
         }
@@ -874,6 +935,12 @@ bool Parser::buildAST() {
         currentToken = eatToken();
     }
 
+    // The tokens are scanned while parsing, the source file is only valid if
+    // the scanner succeeded as well
+    if (!Scan->finishSource()) {
+        return false;
+    }
+
     // Check if required code section exists
     if (FileNode->SecCode == nullptr) {
         // TODO: add color
@@ -885,201 +952,275 @@ bool Parser::buildAST() {
 }
 
 /**
- * Checks if instruction has valid parameters
- * @param instr Pointer to Instruction to type check
- * @param labelRefs Reference to array of label referenced
- * @param funcRefs Reference to array of function referenced
- * @return On success returns true otherwise false
+ * Checks a single instruction operand against a parameter type
+ * @param paramType Type of the parameter
+ * @param param Operand to check
+ * @param type [in/out] Type info operand of the instruction. This assumes that
+ * there can only ever be one TypeInfo in the parameters of an instruction
+ * @param error [out] Set to true if the operand is accepted but its value is
+ * invalid
+ * @return If the parameter accepts the operand returns true otherwise false
  */
-bool Parser::typeCheckInstrParams(Instruction* instr,
-                                  std::vector<Identifier*>& labelRefs) {
-    // Get top node of instruction paramters tree
-    InstrDefNode* paramNode = &(*InstrDefs)[instr->ASMDefIndex];
-
-    // Check if instr has no parameters and see if definiton accepts no
-    // parameters. Important: this assumes that an instruction definiton either
-    // has 0 parameters or only parameter definitons with at least 1. It cannot
-    // have both
-    if (instr->Params.size() == 0) {
-        if (paramNode->Children.size() == 0) {
-            // Attach opcode and return
-            instr->Opcode = paramNode->ParamList->Opcode;
-            instr->EncodingFlags = paramNode->ParamList->Flags;
-            return true;
-        } else {
-            printError(Src, instr->Index, instr->Name.size(), instr->LineRow,
-                       instr->LineCol, "Expected parameters found none");
+bool Parser::checkInstrParam(InstrParamType paramType,
+                             Operand* param,
+                             Operand*& type,
+                             bool& error) {
+    switch (paramType) {
+    case InstrParamType::INT_TYPE: {
+        if (param->Type != OperandType::TYPE_INFO) {
+            return false;
+        }
+        if (param->DataType != UVM_TYPE_I8 &&
+            param->DataType != UVM_TYPE_I16 &&
+            param->DataType != UVM_TYPE_I32 &&
+            param->DataType != UVM_TYPE_I64) {
+            printError(Src, param->Index, param->Size,
+                       "Expected int type found float type");
             return false;
         }
+        type = param;
+    } break;
+    case InstrParamType::FLOAT_TYPE: {
+        if (param->Type != OperandType::TYPE_INFO) {
+            return false;
+        }
+        if (param->DataType != UVM_TYPE_F32 &&
+            param->DataType != UVM_TYPE_F64) {
+            printError(Src, param->Index, param->Size,
+                       "Expected float type found int type");
+            return false;
+        }
+        type = param;
+    } break;
+    case InstrParamType::FUNC_ID:
+        return false;
+    case InstrParamType::LABEL_ID: {
+        if (param->Type != OperandType::IDENTIFIER) {
+            return false;
+        }
+    } break;
+    case InstrParamType::INT_REG: {
+        if (param->Type != OperandType::REGISTER_ID) {
+            return false;
+        }
+        if (getRegisterType(param->Reg) != RegisterType::INTEGER) {
+            printError(Src, param->Index, param->Size,
+                       "Expected integer register");
+            return false;
+        }
+    } break;
+    case InstrParamType::FLOAT_REG: {
+        if (param->Type != OperandType::REGISTER_ID) {
+            return false;
+        }
+        if (getRegisterType(param->Reg) != RegisterType::FLOAT) {
+            printError(Src, param->Index, param->Size,
+                       "Expected float register");
+            return false;
+        }
+    } break;
+    case InstrParamType::REG_OFFSET: {
+        if (param->Type != OperandType::REGISTER_OFFSET) {
+            return false;
+        }
+    } break;
+    case InstrParamType::INT_NUM: {
+        if (param->Type != OperandType::INTEGER_NUMBER) {
+            return false;
+        }
+
+        param->DataType = type->DataType;
+        if (!checkIntWidth(param->Value.Int, param->DataType,
+                           param->Flags & OPERAND_FLAG_SIGNED)) {
+            printError(Src, param->Index, param->Size,
+                       "Integer does not fit into given type");
+            error = true;
+        }
+    } break;
+    case InstrParamType::FLOAT_NUM: {
+        if (param->Type != OperandType::FLOAT_NUMBER) {
+            return false;
+        }
+
+        param->DataType = type->DataType;
+        if (!checkFloatWidth(param->Flags & OPERAND_FLAG_EXCEEDS_F32,
+                             param->DataType)) {
+            printError(Src, param->Index, param->Size,
+                       "Float does not fit into given type");
+            error = true;
+        }
+    } break;
+    case InstrParamType::SYS_INT: {
+        if (param->Type != OperandType::INTEGER_NUMBER) {
+            return false;
+        }
+
+        // syscall args are always 1 byte
+        param->DataType = UVM_TYPE_I8;
+    } break;
     }
+    return true;
+}
 
-    // Try to find instruction parameter signature
-    InstrParamList* paramList = nullptr;
-    InstrDefNode* currentNode = paramNode;
-    // This error does not indicate if a paramlist was found or not
-    bool error = false;
-    // This is a reference used to tag every float/int paramter with the correct
-    // type and select the correct opcode variant. This assumes that there can
-    // only ever be one TypeInfo in the parameters of an instruction.
-    TypeInfo* type = nullptr;
-    for (uint32_t i = 0; i < instr->Params.size(); i++) {
-        InstrDefNode* nextNode = nullptr;
-        for (uint32_t n = 0; n < currentNode->Children.size(); n++) {
-            ASTNode* astNode = instr->Params[i];
-            switch (currentNode->Children[n].Type) {
-            case InstrParamType::INT_TYPE: {
-                if (astNode->Type != ASTType::TYPE_INFO) {
-                    break;
-                }
-                TypeInfo* typeInfo = dynamic_cast<TypeInfo*>(astNode);
-                if (typeInfo->DataType != UVM_TYPE_I8 &&
-                    typeInfo->DataType != UVM_TYPE_I16 &&
-                    typeInfo->DataType != UVM_TYPE_I32 &&
-                    typeInfo->DataType != UVM_TYPE_I64) {
-                    printError(Src, typeInfo->Index, typeInfo->Size,
-                               typeInfo->LineRow, typeInfo->LineCol,
-                               "Expected int type found float type");
-                    break;
-                }
-                type = typeInfo;
-                nextNode = &currentNode->Children[n];
-            } break;
-            case InstrParamType::FLOAT_TYPE: {
-                if (astNode->Type != ASTType::TYPE_INFO) {
-                    break;
-                }
-                TypeInfo* typeInfo = dynamic_cast<TypeInfo*>(astNode);
-                if (typeInfo->DataType != UVM_TYPE_F32 &&
-                    typeInfo->DataType != UVM_TYPE_F64) {
-                    printError(Src, typeInfo->Index, typeInfo->Size,
-                               typeInfo->LineRow, typeInfo->LineCol,
-                               "Expected float type found int type");
-                    break;
-                }
-                type = typeInfo;
-                nextNode = &currentNode->Children[n];
-            } break;
-            case InstrParamType::LABEL_ID: {
-                if (astNode->Type != ASTType::IDENTIFIER) {
-                    break;
-                }
-                Identifier* labelRef = dynamic_cast<Identifier*>(astNode);
-                labelRefs.push_back(labelRef);
-                nextNode = &currentNode->Children[n];
-            } break;
-            case InstrParamType::INT_REG: {
-                if (astNode->Type != ASTType::REGISTER_ID) {
-                    break;
-                }
-                RegisterId* regId = dynamic_cast<RegisterId*>(astNode);
-                if (getRegisterType(regId->Id) != RegisterType::INTEGER) {
-                    printError(Src, regId->Index, regId->Size, regId->LineRow,
-                               regId->LineCol, "Expected integer register");
-                    break;
-                }
-                nextNode = &currentNode->Children[n];
-            } break;
-            case InstrParamType::FLOAT_REG: {
-                if (astNode->Type != ASTType::REGISTER_ID) {
-                    break;
-                }
-                RegisterId* regId = dynamic_cast<RegisterId*>(astNode);
-                if (getRegisterType(regId->Id) != RegisterType::FLOAT) {
-                    printError(Src, regId->Index, regId->Size, regId->LineRow,
-                               regId->LineCol, "Expected float register");
-                    break;
-                }
-                nextNode = &currentNode->Children[n];
-            } break;
-            case InstrParamType::REG_OFFSET: {
-                if (astNode->Type != ASTType::REGISTER_OFFSET) {
-                    break;
-                }
-                nextNode = &currentNode->Children[n];
-            } break;
-            case InstrParamType::INT_NUM: {
-                if (astNode->Type != ASTType::INTEGER_NUMBER) {
-                    break;
-                }
+/**
+ * Reports why no parameter list of an instruction accepts its operands. The
+ * operands are matched one after another against the parameter types which
+ * follow the already matched ones, in the order in which the parameter lists
+ * define them, until an operand is not accepted
+ * @param instr Instruction record without a matching parameter list
+ * @param instrIndex Index of the instruction record
+ */
+void Parser::reportInstrParamMismatch(InstrRecord& instr,
+                                      uint32_t instrIndex) {
+    uint32_t first = Asm::INSTR_PARAM_LIST_INDEX[instr.ASMDefIndex];
+    uint32_t end = Asm::INSTR_PARAM_LIST_INDEX[instr.ASMDefIndex + 1];
+
+    // Instruction definitons either have 0 parameters or only parameter
+    // lists with at least 1
+    if (instr.OperandCount == 0) {
+        printError(Src, instr.Index, instr.Size,
+                   "Expected parameters found none");
+        return;
+    }
 
-                ASTInt* num = dynamic_cast<ASTInt*>(astNode);
-                num->DataType = type->DataType;
-                if (!checkIntWidth(num->Num, num->DataType, num->IsSigned)) {
-                    printError(Src, num->Index, num->Size, num->LineRow,
-                               num->LineCol,
-                               "Integer does not fit into given type");
-                    error = true;
-                }
-                nextNode = &currentNode->Children[n];
-            } break;
-            case InstrParamType::FLOAT_NUM: {
-                if (astNode->Type != ASTType::FLOAT_NUMBER) {
-                    break;
-                }
+    InstrParamType matched[MAX_INSTR_OPERANDS];
+    Operand* type = nullptr;
+    bool error = false;
+    // Surplus operands are not stored in the record
+    uint32_t operandCount =
+        std::min<uint32_t>(instr.OperandCount, MAX_INSTR_OPERANDS);
+    for (uint32_t i = 0; i < operandCount; i++) {
+        Operand* param = &instr.Operands[i];
+        bool accepted = false;
+        for (uint32_t s = first; s < end; s++) {
+            const InstrParamList& paramList = Asm::INSTR_PARAM_LISTS[s];
+            if (paramList.ParamCount <= i ||
+                !std::equal(matched, matched + i, paramList.Params)) {
+                continue;
+            }
 
-                ASTFloat* num = dynamic_cast<ASTFloat*>(astNode);
-                num->DataType = type->DataType;
-                if (!checkFloatWidth(num->Num, num->DataType)) {
-                    printError(Src, num->Index, num->Size, num->LineRow,
-                               num->LineCol,
-                               "Float does not fit into given type");
-                    error = true;
-                }
-                nextNode = &currentNode->Children[n];
-            } break;
-            case InstrParamType::SYS_INT: {
-                if (astNode->Type != ASTType::INTEGER_NUMBER) {
-                    break;
+            // Every parameter type is only checked once at each position
+            bool seen = false;
+            for (uint32_t n = first; n < s && !seen; n++) {
+                const InstrParamList& prev = Asm::INSTR_PARAM_LISTS[n];
+                seen = prev.ParamCount > i &&
+                       std::equal(matched, matched + i, prev.Params) &&
+                       prev.Params[i] == paramList.Params[i];
+            }
+            InstrParamType paramType = paramList.Params[i];
+            if (!seen && checkInstrParam(paramType, param, type, error)) {
+                if (paramType == InstrParamType::LABEL_ID) {
+                    LabelRefs.push_back(makeSymbolRef(*param, instrIndex));
                 }
-
-                ASTInt* num = dynamic_cast<ASTInt*>(astNode);
-                // syscall args are always 1 byte
-                num->DataType = UVM_TYPE_I8;
-                nextNode = &currentNode->Children[n];
-            } break;
+                matched[i] = paramType;
+                accepted = true;
             }
         }
 
-        if (nextNode == nullptr) {
+        if (!accepted) {
+            break;
+        }
+    }
+
+    printError(Src, instr.Index, instr.Size,
+               "Error no matching parameter list found for instruction");
+}
+
+/**
+ * Resolves the parameters of an instruction right after it has been parsed.
+ * Nothing is reported here, instructions which do not match a parameter list
+ * or have immediates which do not fit are type checked again after parsing so
+ * that their errors are reported in the same order as all other type errors
+ * @param instrIndex Index of the instruction record
+ */
+void Parser::resolveInstrParams(uint32_t instrIndex) {
+    InstrRecord& instr = FileNode->Instrs[instrIndex];
+    const InstrParamList* paramList = matchInstrParams(instr);
+    if (paramList == nullptr) {
+        UncheckedInstrs.push_back(instrIndex);
+        return;
+    }
+
+    // Immediates take the type of the type info which precedes them
+    const Operand* type = nullptr;
+    for (uint32_t i = 0; i < instr.OperandCount; i++) {
+        Operand& param = instr.Operands[i];
+        switch (paramList->Params[i]) {
+        case InstrParamType::INT_TYPE:
+        case InstrParamType::FLOAT_TYPE:
+            type = &param;
+            break;
+        case InstrParamType::INT_NUM:
+            if (!checkIntWidth(param.Value.Int, type->DataType,
+                               param.Flags & OPERAND_FLAG_SIGNED)) {
+                UncheckedInstrs.push_back(instrIndex);
+                return;
+            }
+            break;
+        case InstrParamType::FLOAT_NUM:
+            if (!checkFloatWidth(param.Flags & OPERAND_FLAG_EXCEEDS_F32,
+                                 type->DataType)) {
+                UncheckedInstrs.push_back(instrIndex);
+                return;
+            }
+            break;
+        default:
             break;
-        } else {
-            currentNode = nextNode;
         }
+    }
 
-        if (i + 1 == instr->Params.size()) {
-            paramList = currentNode->ParamList;
+    for (uint32_t i = 0; i < instr.OperandCount; i++) {
+        Operand& param = instr.Operands[i];
+        switch (paramList->Params[i]) {
+        case InstrParamType::INT_NUM:
+        case InstrParamType::FLOAT_NUM:
+            param.DataType = type->DataType;
+            break;
+        case InstrParamType::SYS_INT:
+            // syscall args are always 1 byte
+            param.DataType = UVM_TYPE_I8;
+            break;
+        case InstrParamType::LABEL_ID:
+            LabelRefs.push_back(makeSymbolRef(param, instrIndex));
+            break;
+        default:
+            break;
         }
     }
+    attachEncoding(instr, paramList, type);
+}
 
+/**
+ * Checks if instruction has valid parameters and reports all errors
+ * @param instr Instruction record to type check
+ * @param instrIndex Index of the instruction record
+ * @return On success returns true otherwise false
+ */
+bool Parser::typeCheckInstrParams(InstrRecord& instr, uint32_t instrIndex) {
+    const InstrParamList* paramList = matchInstrParams(instr);
     if (paramList == nullptr) {
-        printError(Src, instr->Index, instr->Name.size(), instr->LineRow,
-                   instr->LineCol,
-                   "Error no matching parameter list found for instruction");
+        reportInstrParamMismatch(instr, instrIndex);
         return false;
     }
 
-    if (error) {
-        return false;
+    // This error does not indicate if a paramlist was found or not
+    bool error = false;
+    // This is a reference used to tag every float/int paramter with the correct
+    // type and select the correct opcode variant
+    Operand* type = nullptr;
+    for (uint32_t i = 0; i < instr.OperandCount; i++) {
+        InstrParamType paramType = paramList->Params[i];
+        checkInstrParam(paramType, &instr.Operands[i], type, error);
+        if (paramType == InstrParamType::LABEL_ID) {
+            LabelRefs.push_back(makeSymbolRef(instr.Operands[i], instrIndex));
+        }
     }
 
-    // Check if the opcode is determined by a type variant and attach the opcode
-    // to the Instruction node
-    if (paramList->Flags & INSTR_FLAG_TYPE_VARIANTS) {
-        uint8_t opcode = 0;
-        // Find opcode variant
-        for (uint32_t i = 0; i < paramList->OpcodeVariants.size(); i++) {
-            TypeVariant* variant = &paramList->OpcodeVariants[i];
-            if (variant->Type == type->DataType) {
-                opcode = variant->Opcode;
-            }
-        }
-        instr->Opcode = opcode;
-    } else {
-        instr->Opcode = paramList->Opcode;
+    if (error) {
+        return false;
     }
-    // Attach encoding information
-    instr->EncodingFlags = paramList->Flags;
 
+    attachEncoding(instr, paramList, type);
     return true;
 }
 
@@ -1092,20 +1233,12 @@ bool Parser::typeCheckVars(ASTSection* sec) {
 
     // Check for variable redefinitons
     for (ASTNode* node : sec->Body) {
-        ASTVariable* var = dynamic_cast<ASTVariable*>(node);
+        ASTVariable* var = nodeCast<ASTVariable>(node);
 
         // Check if var has already been declared
-        bool exists = false;
-        for (VarDeclaration& varDecl : *VarDecls) {
-            if (varDecl.Id->Name == var->Id->Name) {
-                exists = true;
-                break;
-            }
-        }
-
-        if (exists) {
-            printError(Src, var->Index, var->Size, var->LineRow, var->LineCol,
-                       "Variable redefiniton");
+        Symbol& sym = Symbols->get(var->Id->SymbolId);
+        if (sym.VarDecl != SYMBOL_UNDEFINED) {
+            printError(Src, var->Index, var->Size, "Variable redefiniton");
             valid = false;
             continue;
         }
@@ -1126,6 +1259,7 @@ bool Parser::typeCheckVars(ASTSection* sec) {
         }
 
         var->VarDeclIndex = VarDecls->size();
+        sym.VarDecl = var->VarDeclIndex;
         VarDecls->push_back(varDecl);
     }
 
@@ -1138,37 +1272,13 @@ bool Parser::typeCheckVars(ASTSection* sec) {
  */
 bool Parser::checkVarRefs() {
     bool valid = true;
-
-    for (ASTNode* node : FileNode->SecCode->Body) {
-        if (node->Type == ASTType::INSTRUCTION) {
-            Instruction* instr = dynamic_cast<Instruction*>(node);
-            for (ASTNode* instrParam : instr->Params) {
-                if (instrParam->Type == ASTType::REGISTER_OFFSET) {
-                    RegisterOffset* ro =
-                        dynamic_cast<RegisterOffset*>(instrParam);
-                    // If register offset has label as its content check if the
-                    // var exists
-                    if (ro->Var != nullptr) {
-                        bool exists = false;
-                        for (VarDeclaration& decl : *VarDecls) {
-                            if (decl.Id->Name == ro->Var->Name) {
-                                exists = true;
-                                break;
-                            }
-                        }
-
-                        if (!exists) {
-                            printError(Src, ro->Var->Index, ro->Var->Size,
-                                       ro->Var->LineRow, ro->Var->LineCol,
-                                       "Variable reference does not exist");
-                            valid = false;
-                        }
-                    }
-                }
-            }
+    for (const SymbolRef& ref : VarRefs) {
+        if (Symbols->get(ref.SymbolId).VarDecl == SYMBOL_UNDEFINED) {
+            printError(Src, ref.Index, ref.Size,
+                       "Variable reference does not exist");
+            valid = false;
         }
     }
-
     return valid;
 }
 
@@ -1192,22 +1302,22 @@ bool Parser::typeCheck() {
         }
     }
 
-    // Check if code section AST node has no children which means the main
-    // function is missing for sure
-    if (FileNode->SecCode->Body.size() == 0) {
+    std::vector<InstrRecord>& instrs = FileNode->Instrs;
+    std::vector<LabelDef*>& labels = FileNode->Labels;
+
+    // Check if code section has no instructions and labels which means the
+    // main function is missing for sure
+    if (instrs.empty() && labels.empty()) {
         std::cout << "[Type Checker] Missing main label\n";
         return false;
     }
 
     // Try to find main entry point
+    uint32_t mainId = Symbols->find("main");
     LabelDef* mainEntry = nullptr;
-    for (uint32_t i = 0; i < FileNode->SecCode->Body.size(); i++) {
-        ASTNode* node = FileNode->SecCode->Body[i];
-        if (node->Type == ASTType::LABEL_DEFINITION) {
-            LabelDef* label = dynamic_cast<LabelDef*>(node);
-            if (label->Name == "main") {
-                mainEntry = label;
-            }
+    for (LabelDef* label : labels) {
+        if (label->SymbolId == mainId) {
+            mainEntry = label;
         }
     }
 
@@ -1217,57 +1327,52 @@ bool Parser::typeCheck() {
         return false;
     }
 
-    // This is used to keep track of the localy referenced function and label
-    // identifiers aswell as localy defined label definitions
-    std::vector<Identifier*> labelRefs;
-
-    // Type check complete AST. This assumes that the build AST generated a
-    // valid AST
-    for (const auto& globElem : FileNode->SecCode->Body) {
-        if (globElem->Type == ASTType::LABEL_DEFINITION) {
-            LabelDef* label = dynamic_cast<LabelDef*>(globElem);
-
-            // Check if function definition is redifined
-            bool labelRedef = false;
-            for (uint32_t i = 0; i < LabelDefs->size(); i++) {
-                if ((*LabelDefs)[i].Def->Name == label->Name) {
-                    labelRedef = true;
-                    break;
-                }
-            }
-
-            // If function is a redefinition continue with parsing the function
-            // body anyway
-            if (labelRedef) {
-                printError(Src, label->Index, label->Name.size(),
-                           label->LineRow, label->LineCol,
-                           "Label is already defined");
-                typeCheckError = true;
-            }
-            LabelDefs->push_back(LabelDefLookup{label, 0});
-        } else if (globElem->Type == ASTType::INSTRUCTION) {
-            Instruction* instr = dynamic_cast<Instruction*>(globElem);
-            if (!typeCheckInstrParams(instr, labelRefs)) {
+    // Instructions have been resolved while parsing, only the ones which
+    // failed are checked again to report their errors. They are checked in
+    // source order together with the label definitions
+    uint32_t uncheckedIndex = 0;
+    for (uint32_t i = 0; i <= labels.size(); i++) {
+        // Instructions are handled before the labels which follow them
+        uint32_t end = i < labels.size() ? labels[i]->InstrIndex : UINT32_MAX;
+        while (uncheckedIndex < UncheckedInstrs.size() &&
+               UncheckedInstrs[uncheckedIndex] < end) {
+            uint32_t instrIndex = UncheckedInstrs[uncheckedIndex];
+            uncheckedIndex++;
+            if (!typeCheckInstrParams(instrs[instrIndex], instrIndex)) {
                 typeCheckError = true;
-                continue;
             }
         }
-    }
 
-    // Check if all label references are resolved
-    for (const auto& labelRef : labelRefs) {
-        bool foundDef = false;
-        for (uint32_t i = 0; i < LabelDefs->size(); i++) {
-            if (labelRef->Name == (*LabelDefs)[i].Def->Name) {
-                foundDef = true;
-                break;
-            }
+        if (i == labels.size()) {
+            break;
+        }
+
+        // If function is a redefinition continue with parsing the function
+        // body anyway. References resolve to the first definition
+        LabelDef* label = labels[i];
+        Symbol& sym = Symbols->get(label->SymbolId);
+        if (sym.Label != nullptr) {
+            printError(Src, label->Index, sym.Name.size(),
+                       "Label is already defined");
+            typeCheckError = true;
+        } else {
+            sym.Label = label;
         }
+    }
 
-        if (!foundDef) {
-            printError(Src, labelRef->Index, labelRef->Name.size(),
-                       labelRef->LineRow, labelRef->LineCol,
-                       "Unresolved label");
+    // Label references of the checked instructions have been appended, bring
+    // them back into source order
+    if (!UncheckedInstrs.empty()) {
+        std::stable_sort(LabelRefs.begin(), LabelRefs.end(),
+                         [](const SymbolRef& a, const SymbolRef& b) {
+                             return a.InstrIndex < b.InstrIndex;
+                         });
+    }
+
+    // Check if all label references are resolved
+    for (const SymbolRef& ref : LabelRefs) {
+        if (Symbols->get(ref.SymbolId).Label == nullptr) {
+            printError(Src, ref.Index, ref.Size, "Unresolved label");
             typeCheckError = true;
         }
     }
@@ -1276,5 +1381,11 @@ bool Parser::typeCheck() {
         typeCheckError = true;
     };
 
+    // All references are resolved, release them before the bytecode is
+    // generated
+    std::vector<uint32_t>().swap(UncheckedInstrs);
+    std::vector<SymbolRef>().swap(LabelRefs);
+    std::vector<SymbolRef>().swap(VarRefs);
+
     return !typeCheckError;
 }
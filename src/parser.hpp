@@ -18,6 +18,7 @@
 #include "asm/asm.hpp"
 #include "ast.hpp"
 #include "scanner.hpp"
+#include "symbolTable.hpp"
 #include "token.hpp"
 #include <vector>
 
@@ -40,49 +41,75 @@ struct VarDeclaration {
     uint8_t SecPerm = 0;
 };
 
+/**
+ * Reference of an instruction operand to a label or variable. References are
+ * recorded while parsing and resolved once the whole source file is known
+ */
+struct SymbolRef {
+    uint32_t SymbolId = 0;
+    /** Index of the referring instruction record */
+    uint32_t InstrIndex = 0;
+    /** Index of the operand string in the source file */
+    uint32_t Index = 0;
+    /** Size of the operand string */
+    uint32_t Size = 0;
+};
+
 enum class RegisterType {
     INTEGER,
     FLOAT,
 };
 
-bool strToInt(std::string& str, uint64_t& num);
-bool strToFP(std::string& str, double& num);
-
 class Parser {
   public:
-    Parser(std::vector<InstrDefNode>* instrDefs,
-           SourceFile* src,
-           const std::vector<Token>* tokens,
+    Parser(SourceFile* src,
+           Scanner* scan,
            ASTFileNode* fileNode,
-           std::vector<LabelDefLookup>* funcDefs,
-           std::vector<VarDeclaration>* varDecls);
+           SymbolTable* symbols,
+           std::vector<VarDeclaration>* varDecls,
+           std::vector<uint8_t>* strings,
+           ASTArena* nodes);
     bool buildAST();
     bool typeCheck();
 
   private:
-    uint64_t Cursor = 0;
-
-    /** Non owning pointer to instruction definitons */
-    std::vector<InstrDefNode>* InstrDefs = nullptr;
-    /** Non owning vector of token */
-    const std::vector<Token>* Tokens = nullptr;
-    /** Vector of non owning pointers to function declarations */
-    std::vector<LabelDefLookup>* LabelDefs = nullptr;
-    std::vector<VarDeclaration>* VarDecls;
-    /** Non owning pointer to file node node */
-    ASTFileNode* FileNode;
     /** Non owning pointer to source file */
     SourceFile* Src;
-    Token* eatToken();
-    Token* peekToken();
+    /** Non owning pointer to the scanner which hands out the tokens */
+    Scanner* Scan = nullptr;
+    /** Non owning pointer to file node node */
+    ASTFileNode* FileNode;
+    /** Non owning pointer to the symbol table of labels and variables */
+    SymbolTable* Symbols = nullptr;
+    std::vector<VarDeclaration>* VarDecls;
+    /** Non owning pointer to the arena of decoded strings */
+    std::vector<uint8_t>* Strings = nullptr;
+    /** Non owning pointer to the arena which owns all AST nodes */
+    ASTArena* Nodes = nullptr;
+    /**
+     * Indices of the instructions whose parameters could not be resolved while
+     * parsing. They are type checked again to report their errors
+     */
+    std::vector<uint32_t> UncheckedInstrs;
+    /** Label references of the code section */
+    std::vector<SymbolRef> LabelRefs;
+    /** Variable references of the code section in order of appearance */
+    std::vector<SymbolRef> VarRefs;
+    Token eatToken();
+    Token peekToken();
     void skipLine();
-    void printTokenError(const char* msg, Token& tok);
-    void parseStringEscape(std::string& inStr, std::string& outStr);
-    bool parseRegOffset(Instruction* instr);
+    void printTokenError(const char* msg, const Token& tok);
+    void parseStringEscape(std::string_view inStr);
+    bool parseRegOffset(Operand& regOff);
     bool parseSectionVars(ASTSection* sec);
     bool parseSectionCode();
-    bool typeCheckInstrParams(Instruction* instr,
-                              std::vector<Identifier*>& labelRefs);
+    bool checkInstrParam(InstrParamType paramType,
+                         Operand* param,
+                         Operand*& type,
+                         bool& error);
+    void reportInstrParamMismatch(InstrRecord& instr, uint32_t instrIndex);
+    void resolveInstrParams(uint32_t instrIndex);
+    bool typeCheckInstrParams(InstrRecord& instr, uint32_t instrIndex);
     bool typeCheckVars(ASTSection* sec);
     bool checkVarRefs();
 };
@@ -15,28 +15,51 @@
 // ======================================================================== //
 
 #include "../cli.hpp"
+#include "../fileMap.hpp"
+#include "../fileWrite.hpp"
+#include "../pages.hpp"
+#include <climits>
+#include <fcntl.h>
 #include <iomanip>
 #include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#ifdef IOV_MAX
+/** Maximum amount of slices which are passed to a single writev call */
+constexpr int WRITE_SLICE_LIMIT = IOV_MAX;
+#else
+constexpr int WRITE_SLICE_LIMIT = 16;
+#endif
+
+/**
+ * Files smaller than this are read into memory completely when they are mapped
+ * instead of being paged in on first access
+ */
+constexpr uint32_t MAP_POPULATE_LIMIT = 4 * 1024 * 1024;
 
 /**
  * Prints an error to the console with colors [linux and macOS only]
  * @param Pointer to the source file where the source of the error is
  * @param index Index of the error in the source file
  * @param size Size of the error substring
- * @param row Row on which the error occured
- * @param column Column on which the error occured
  * @param msg Pointer to the error message title
  */
 void printError(SourceFile* src,
                 uint32_t index,
                 uint32_t size,
-                uint32_t row,
-                uint32_t column,
                 const char* msg) {
 
     // Left margin of the source code snippet
     constexpr uint32_t TAB = 4;
 
+    // Get the row and column where the error occured
+    uint32_t row = 0;
+    uint32_t column = 0;
+    src->getPosition(index, row, column);
+
     // Get the whole line where the error occured
     std::string sourceLine;
     uint32_t lineIndex = 0;
@@ -82,3 +105,142 @@ void printError(SourceFile* src,
     std::cerr << std::setfill('~') << std::setw(size) << '~' << "\n\n"
               << FG_WHITE;
 }
+
+/**
+ * Maps a regular file read only into memory [linux and macOS only]. The file
+ * content is followed by the given amount of zero bytes
+ * @param path Path to the file
+ * @param padding Amount of zero bytes behind the file content
+ * @param size [out] Size of the file content
+ * @return Pointer to the mapped file or nullptr if the file cannot be mapped
+ */
+uint8_t* mapFile(const char* path, uint32_t padding, uint32_t& size) {
+    // Pipes, special files and empty files cannot be mapped. They have to be
+    // checked before opening because opening a named pipe connects a writer
+    struct stat info;
+    if (stat(path, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size <= 0 ||
+        (uint64_t)info.st_size > UINT32_MAX - padding) {
+        return nullptr;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    uint32_t fileSize = info.st_size;
+
+    // Reserve zero pages for the file content and the padding and map the file
+    // over the front of them. The rest of the last file page is zero as well
+    void* reserved = mmap(nullptr, fileSize + padding, PROT_READ,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (reserved == MAP_FAILED) {
+        close(fd);
+        return nullptr;
+    }
+
+    int flags = MAP_PRIVATE | MAP_FIXED;
+#ifdef MAP_POPULATE
+    if (fileSize < MAP_POPULATE_LIMIT) {
+        flags |= MAP_POPULATE;
+    }
+#endif
+    void* data = mmap(reserved, fileSize, PROT_READ, flags, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        munmap(reserved, fileSize + padding);
+        return nullptr;
+    }
+
+    // The scanner runs over the file from front to back
+    madvise(data, fileSize, MADV_SEQUENTIAL);
+
+    size = fileSize;
+    return (uint8_t*)data;
+}
+
+/**
+ * Unmaps a file which has been mapped by mapFile() [linux and macOS only]
+ * @param data Pointer to the mapped file
+ * @param size Size of the file content
+ * @param padding Amount of zero bytes behind the file content
+ */
+void unmapFile(uint8_t* data, uint32_t size, uint32_t padding) {
+    munmap(data, size + padding);
+}
+
+/**
+ * Creates or truncates a file and writes the slices one after another into it
+ * with gather writes [linux and macOS only]. All slices are written by a
+ * single writev call unless there are more than WRITE_SLICE_LIMIT of them or
+ * the kernel writes less than requested
+ * @param path Path to the file
+ * @param slices Pointer to the slices
+ * @param count Amount of slices
+ * @return On success returns true otherwise false
+ */
+bool writeFileSlices(const char* path, const FileSlice* slices, size_t count) {
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if (fd < 0) {
+        return false;
+    }
+
+    iovec vecs[WRITE_SLICE_LIMIT];
+    size_t next = 0;
+    // Amount of bytes of the slice at next which have been written already
+    size_t written = 0;
+    while (next < count) {
+        int vecCount = 0;
+        for (size_t i = next; i < count && vecCount < WRITE_SLICE_LIMIT; i++) {
+            size_t skip = i == next ? written : 0;
+            vecs[vecCount].iov_base = (void*)(slices[i].Data + skip);
+            vecs[vecCount].iov_len = slices[i].Size - skip;
+            vecCount++;
+        }
+
+        ssize_t res = writev(fd, vecs, vecCount);
+        if (res <= 0) {
+            close(fd);
+            return false;
+        }
+
+        // Skip the slices which have been written completely
+        size_t remaining = res;
+        while (next < count && remaining >= slices[next].Size - written) {
+            remaining -= slices[next].Size - written;
+            written = 0;
+            next++;
+        }
+        written += remaining;
+    }
+
+    return close(fd) == 0;
+}
+
+/**
+ * Allocates zeroed memory pages [linux and macOS only]. Transparent huge pages
+ * are requested for them where they are supported
+ * @param size Size of the memory, should be a multiple of the page size
+ * @return Pointer to the pages or nullptr if they could not be allocated
+ */
+void* allocatePages(size_t size) {
+    void* pages = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pages == MAP_FAILED) {
+        return nullptr;
+    }
+
+#ifdef MADV_HUGEPAGE
+    madvise(pages, size, MADV_HUGEPAGE);
+#endif
+    return pages;
+}
+
+/**
+ * Frees memory pages which have been allocated by allocatePages() [linux and
+ * macOS only]
+ * @param pages Pointer to the pages
+ * @param size Size of the memory
+ */
+void freePages(void* pages, size_t size) {
+    munmap(pages, size);
+}
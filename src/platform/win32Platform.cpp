@@ -15,6 +15,9 @@
 // ======================================================================== //
 
 #include "../cli.hpp"
+#include "../fileMap.hpp"
+#include "../fileWrite.hpp"
+#include "../pages.hpp"
 #include <Windows.h>
 #include <iomanip>
 #include <iostream>
@@ -24,20 +27,21 @@
  * @param Pointer to the source file where the source of the error is
  * @param index Index of the error in the source file
  * @param size Size of the error substring
- * @param row Row on which the error occured
- * @param column Column on which the error occured
  * @param msg Pointer to the error message title
  */
 void printError(SourceFile* src,
                 uint32_t index,
                 uint32_t size,
-                uint32_t row,
-                uint32_t column,
                 const char* msg) {
 
     // Left margin of the source code snippet
     constexpr uint32_t TAB = 4;
 
+    // Get the row and column where the error occured
+    uint32_t row = 0;
+    uint32_t column = 0;
+    src->getPosition(index, row, column);
+
     // Get the whole line where the error occured
     std::string sourceLine;
     uint32_t lineIndex = 0;
@@ -98,3 +102,54 @@ void printError(SourceFile* src,
     // Reset font color to white
     SetConsoleTextAttribute(handle, FG_WHITE);
 }
+
+/**
+ * Maps a file into memory [win32 only]. A read only file mapping cannot be
+ * extended by zero padding, source files are always read into a buffer instead
+ * @param path Path to the file
+ * @param padding Amount of zero bytes behind the file content
+ * @param size [out] Size of the file content
+ * @return Always nullptr
+ */
+uint8_t* mapFile(const char* path, uint32_t padding, uint32_t& size) {
+    return nullptr;
+}
+
+/**
+ * Unmaps a file which has been mapped by mapFile() [win32 only]
+ * @param data Pointer to the mapped file
+ * @param size Size of the file content
+ * @param padding Amount of zero bytes behind the file content
+ */
+void unmapFile(uint8_t* data, uint32_t size, uint32_t padding) {}
+
+/**
+ * Writes slices into a file with gather writes [win32 only]. Gather writes are
+ * not supported for buffered files, the caller writes the file itself
+ * @param path Path to the file
+ * @param slices Pointer to the slices
+ * @param count Amount of slices
+ * @return Always false
+ */
+bool writeFileSlices(const char* path, const FileSlice* slices, size_t count) {
+    return false;
+}
+
+/**
+ * Allocates zeroed memory pages [win32 only]
+ * @param size Size of the memory, should be a multiple of the page size
+ * @return Pointer to the pages or nullptr if they could not be allocated
+ */
+void* allocatePages(size_t size) {
+    return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT,
+                        PAGE_READWRITE);
+}
+
+/**
+ * Frees memory pages which have been allocated by allocatePages() [win32 only]
+ * @param pages Pointer to the pages
+ * @param size Size of the memory
+ */
+void freePages(void* pages, size_t size) {
+    VirtualFree(pages, 0, MEM_RELEASE);
+}
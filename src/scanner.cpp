@@ -17,300 +17,355 @@
 #include "scanner.hpp"
 #include "asm/asm.hpp"
 #include "asm/encoding.hpp"
+#include "byteSearch.hpp"
 #include "cli.hpp"
-#include <iomanip>
-#include <iostream>
+#include "literal.hpp"
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cstdint>
+#include <thread>
 
 /**
- * Constructs a new Scanner instance
- * @param src Pointer to the source file
- * @param outTokens [out] Pointer to the output token vector
+ * Determines how the scanner continues when it finds a char at the start of a
+ * token
  */
-Scanner::Scanner(SourceFile* src, std::vector<Token>* outTokens)
-    : Src(src), Tokens(outTokens) {
-    Cursor = 0;
-    CursorLineRow = 1;
-    CursorLineColumn = 1;
+enum class CharClass : uint8_t {
+    INVALID,
+    END,
+    BLANK,
+    NEW_LINE,
+    CARRIAGE_RETURN,
+    LETTER,
+    UNDERSCORE,
+    DIGIT,
+    QUOTE,
+    AT_SIGN,
+    SLASH,
+    PUNCTUATOR,
+};
+
+// Properties of a char inside of a token
+constexpr uint8_t CHAR_FLAG_LETTER = 0x01;     // [a-zA-Z]
+constexpr uint8_t CHAR_FLAG_WORD = 0x02;       // [a-zA-Z0-9_]
+constexpr uint8_t CHAR_FLAG_WORD_END = 0x04;   // [ \t{\n\r,\]+\-*:=]
+constexpr uint8_t CHAR_FLAG_DIGIT = 0x08;      // [0-9]
+constexpr uint8_t CHAR_FLAG_HEX = 0x10;        // [0-9a-fA-F]
+constexpr uint8_t CHAR_FLAG_NUMBER_END = 0x20; // [\0 \n\t,\r\]]
+
+/**
+ * Builds the table which maps every char to its char class
+ * @return Char class table
+ */
+static constexpr std::array<CharClass, 256> buildCharClasses() {
+    std::array<CharClass, 256> table{};
+    for (char c = 'a'; c <= 'z'; c++) {
+        table[c] = CharClass::LETTER;
+        table[c - 'a' + 'A'] = CharClass::LETTER;
+    }
+    for (char c = '0'; c <= '9'; c++) {
+        table[c] = CharClass::DIGIT;
+    }
+    for (char c : {'+', '-', '*', ',', '[', ']', '{', '}', ':', '='}) {
+        table[c] = CharClass::PUNCTUATOR;
+    }
+    table['\0'] = CharClass::END;
+    table[' '] = CharClass::BLANK;
+    table['\t'] = CharClass::BLANK;
+    table['\n'] = CharClass::NEW_LINE;
+    table['\r'] = CharClass::CARRIAGE_RETURN;
+    table['_'] = CharClass::UNDERSCORE;
+    table['"'] = CharClass::QUOTE;
+    table['@'] = CharClass::AT_SIGN;
+    table['/'] = CharClass::SLASH;
+    return table;
 }
 
 /**
- * Increments the line row
+ * Builds the table which maps every char to its CHAR_FLAG_* bits
+ * @return Char flag table
  */
-void Scanner::incLineRow() {
-    CursorLineRow++;
-    CursorLineColumn = 0;
-};
+static constexpr std::array<uint8_t, 256> buildCharFlags() {
+    std::array<uint8_t, 256> table{};
+    for (char c = 'a'; c <= 'z'; c++) {
+        table[c] |= CHAR_FLAG_LETTER | CHAR_FLAG_WORD;
+        table[c - 'a' + 'A'] |= CHAR_FLAG_LETTER | CHAR_FLAG_WORD;
+    }
+    for (char c = '0'; c <= '9'; c++) {
+        table[c] |= CHAR_FLAG_WORD | CHAR_FLAG_DIGIT | CHAR_FLAG_HEX;
+    }
+    for (char c = 'a'; c <= 'f'; c++) {
+        table[c] |= CHAR_FLAG_HEX;
+        table[c - 'a' + 'A'] |= CHAR_FLAG_HEX;
+    }
+    table['_'] |= CHAR_FLAG_WORD;
+    for (char c : {' ', '\t', '{', '\n', '\r', ',', ']', '+', '-', '*', ':',
+                   '='}) {
+        table[c] |= CHAR_FLAG_WORD_END;
+    }
+    for (char c : {'\0', ' ', '\n', '\t', ',', '\r', ']'}) {
+        table[c] |= CHAR_FLAG_NUMBER_END;
+    }
+    return table;
+}
 
 /**
- * Increments the cursor
+ * Builds the table which maps punctuator chars to their token type
+ * @return Punctuator token type table
  */
-void Scanner::incCursor() {
-    Cursor++;
-    CursorLineColumn++;
+static constexpr std::array<TokenType, 256> buildPunctuatorTypes() {
+    std::array<TokenType, 256> table{};
+    table['+'] = TokenType::PLUS_SIGN;
+    table['-'] = TokenType::MINUS_SIGN;
+    table['*'] = TokenType::ASTERISK;
+    table[','] = TokenType::COMMA;
+    table['['] = TokenType::LEFT_SQUARE_BRACKET;
+    table[']'] = TokenType::RIGHT_SQUARE_BRACKET;
+    table['{'] = TokenType::LEFT_CURLY_BRACKET;
+    table['}'] = TokenType::RIGHT_CURLY_BRACKET;
+    table[':'] = TokenType::COLON;
+    table['='] = TokenType::EQUALS_SIGN;
+    return table;
 }
 
+static constexpr std::array<CharClass, 256> CHAR_CLASSES = buildCharClasses();
+static constexpr std::array<uint8_t, 256> CHAR_FLAGS = buildCharFlags();
+static constexpr std::array<TokenType, 256> PUNCTUATOR_TYPES =
+    buildPunctuatorTypes();
+
 /**
- * Returns the char at the current Cursor index from the source file after
- * increasing the Cursor
- * @return On success returns char. At end of file returns 0
+ * Checks if a char has at least one of the given CHAR_FLAG_* bits set
+ * @param c Char to check
+ * @param flags CHAR_FLAG_* bits
+ * @return If one of the bits is set returns true otherwise false
  */
-char Scanner::eatChar() {
-    incCursor();
-    if (Cursor >= Src->getSize()) {
-        return 0;
-    }
-    char c = 0;
-    Src->getChar(Cursor, c);
-    return c;
+static bool hasFlag(uint8_t c, uint8_t flags) {
+    return (CHAR_FLAGS[c] & flags) != 0;
 }
 
 /**
- * Skips ahead in the source file
- * Note: This does not take new lines into account and will not increase the
- * line row if a \n is skipped
- * @param count Amount of chars to skip
+ * Constructs a new Scanner instance
+ * @param src Pointer to the source file
+ * @param outTokens [out] Pointer to the output token stream
  */
-void Scanner::skipChar(uint32_t count) {
-    Cursor += count;
-    CursorLineColumn += count;
+Scanner::Scanner(SourceFile* src, TokenStream* outTokens)
+    : Src(src), Tokens(outTokens) {
+    Start = Src->getData();
+    End = &Start[Src->getSize()];
+    Cursor = Start;
 }
 
 /**
- * Peeks the next token without increasing the Cursor
- * @return On success returns char. At end of file returns 0
+ * Constructs a new Scanner instance which only scans a chunk of the source
+ * file. Unless the chunk is at the end of the source file it has to end behind
+ * a new line, no token can cross it then
+ * @param src Pointer to the source file
+ * @param outTokens [out] Pointer to the output token stream
+ * @param begin Index of the first char of the chunk
+ * @param end Index behind the last char of the chunk
  */
-char Scanner::peekChar() {
-    if (Cursor + 1 >= Src->getSize()) {
-        return 0;
-    }
-    char c = 0;
-    Src->getChar(Cursor + 1, c);
-    return c;
+Scanner::Scanner(SourceFile* src,
+                 TokenStream* outTokens,
+                 uint32_t begin,
+                 uint32_t end)
+    : Src(src), Tokens(outTokens) {
+    Start = Src->getData();
+    End = &Start[end];
+    Cursor = &Start[begin];
 }
 
 /**
- * Checks if a token is an instruction. If so it will attach the instruction
- * encoding id to the tag
- * @param token The token to check
- * @param tag [out] If token is an instruction tag will hold the instruction
- * encoding id
- * @return On instruction will return true otherwise false
+ * Reports a diagnostic. It is either printed right away or collected if the
+ * scanner works on a chunk
+ * @param index Index of the error in the source file
+ * @param size Size of the error substring
+ * @param msg Pointer to the error message
  */
-bool Scanner::isInstruction(std::string& token, uint8_t& tag) {
-    bool isInstr = false;
-    auto iter = Asm::INSTR_NAMES.find(token);
-    if (iter != Asm::INSTR_NAMES.end()) {
-        tag = iter->second;
-        isInstr = true;
+void Scanner::reportError(uint32_t index, uint32_t size, const char* msg) {
+    if (Errors != nullptr) {
+        Errors->push_back(ScanError{index, size, msg});
+    } else {
+        printError(Src, index, size, msg);
     }
-
-    return isInstr;
 }
 
 /**
- * Checks if a token is a type info. If so it will attach the type id to the tag
- * @param token The token to check
- * @param tag [out] If token is a type info tag will hold the type id
- * @return On type will return true otherwise false
+ * Moves the Cursor to the new line at the end of the current line or to the
+ * end of the source file if there is none
  */
-bool Scanner::isTypeInfo(std::string& token, uint8_t& tag) {
-    bool isTypeInfo = false;
-    auto iter = UVM_TYPE_DEFS.find(token);
-    if (iter != UVM_TYPE_DEFS.end()) {
-        tag = iter->second;
-        isTypeInfo = true;
-    }
-    return isTypeInfo;
+void Scanner::skipLine() {
+    Cursor = findByte(Cursor, End, '\n');
 }
 
 /**
- * Checks if a token is a register. If so it will attach the register id to the
- * tag
- * @param token The token to check
- * @param tag [out] If token is a register tag will hold the register id
- * @return On register will return true otherwise false
+ * Skips a single line comment. The Cursor has to point at the first '/' and
+ * will point at the new line afterwards
  */
-bool Scanner::isRegister(std::string& token, uint8_t& tag) {
-    bool isRegister = false;
-    auto iter = ASM_REGISTERS.find(token);
-    if (iter != ASM_REGISTERS.end()) {
-        tag = iter->second;
-        isRegister = true;
-    }
-    return isRegister;
+void Scanner::skipLineComment() {
+    Cursor = findByte(&Cursor[2], End, '\n');
 }
 
 /**
- * Skips the current line where the Cursor is on
+ * Skips a multiline comment. The Cursor has to point at the opening '/' and
+ * will point behind the closing '/' afterwards
  */
-void Scanner::skipLine() {
-    char c = ' ';
-    Src->getChar(Cursor, c);
+void Scanner::skipBlockComment() {
+    Cursor += 2;
+    skipCommentBody();
+}
 
-    if (c == '\n') {
-        return;
-    }
+/**
+ * Skips the rest of a multiline comment including the closing star and slash.
+ * If the comment is not terminated the Cursor will point at End and
+ * InBlockComment is set
+ */
+void Scanner::skipCommentBody() {
+    const uint8_t* c = Cursor;
+
+    // Stop at every '*' to check if it closes the comment. A '*' is never the
+    // last char in front of End because the source file is followed by zero
+    // padding and chunks end with a new line
+    while (true) {
+        c = findByte(c, End, '*');
+        if (c == End) {
+            Cursor = End;
+            InBlockComment = true;
+            return;
+        }
 
-    char peek = peekChar();
-    while (peek != 0 && peek != '\n') {
-        incCursor();
-        peek = peekChar();
+        if (c[1] == '/') {
+            Cursor = &c[2];
+            InBlockComment = false;
+            return;
+        }
+        c++;
     }
 }
 
 /**
  * Scans a word which starts with [a-zA-Z] contains [a-zA-Z_0-9]+ terminated by
- * [ \t{\n\r,\]+\-*:=]
- * @param outSize The word size
+ * [ \t{\n\r,\]+\-*:=]. The Cursor will point behind the word afterwards or at
+ * the first unexpected char
+ * @param outSize [out] The word size is added to it
  * @return On valid word returns true otherwise false
  */
 bool Scanner::scanWord(uint32_t& outSize) {
-    char c = ' ';
-    Src->getChar(Cursor, c);
-    bool validWord = true;
-    char peek = peekChar();
-
-    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
-        outSize++;
-    } else {
+    const uint8_t* c = Cursor;
+    if (!hasFlag(*c, CHAR_FLAG_LETTER)) {
         return false;
     }
 
-    while (peek != '\t' && peek != ' ' && peek != '{' && peek != '\n' &&
-           peek != '\r' && peek != ',' && peek != ']' && peek != '+' &&
-           peek != '-' && peek != '*' && peek != ':' && peek != '=') {
-        c = eatChar();
-        if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '_' ||
-            (c >= '0' && c <= '9')) {
-            outSize++;
-            peek = peekChar();
-        } else {
-            validWord = false;
-            break;
-        }
+    c++;
+    while (hasFlag(*c, CHAR_FLAG_WORD)) {
+        c++;
     }
 
-    return validWord;
+    outSize += c - Cursor;
+    Cursor = c;
+    return hasFlag(*c, CHAR_FLAG_WORD_END);
 }
 
 /**
- * Scans a string declared by "..."
+ * Scans a string declared by "...". The Cursor will point behind the closing
+ * quote afterwards or at the new line if the string is not terminated
  * @param outSize [out] Size of the string
  * @return On valid string returns true otherwise false
  */
 bool Scanner::scanString(uint32_t& outSize) {
-    bool validString = true;
-
-    // Get first char and peek
-    char c = ' ';
-    Src->getChar(Cursor, c);
-    char peek = peekChar();
-    outSize++;
-
-    // String cannot not be on multiple lines
-    bool strClosed = false;
-    while (!strClosed) {
-        c = eatChar();
-        peek = peekChar();
+    const uint8_t* start = Cursor;
+    const uint8_t* c = &start[1];
+
+    // Jump from one quote, backslash or new line to the next
+    while (true) {
+        c = findAnyOf(c, End, '"', '\\', '\n');
+
+        // String cannot be on multiple lines
+        if (c == End || *c == '\n') {
+            outSize = c - start - 1;
+            Cursor = c;
+            return false;
+        }
 
-        // Ignore escaped quote and escaped backslash
-        if (c == '\\' && (peek == '"' || peek == '\\')) {
-            c = eatChar();
-            c = eatChar();
-            outSize += 2;
+        if (*c == '"') {
+            outSize = c - start + 1;
+            Cursor = &c[1];
+            return true;
         }
 
-        if (c == '"') {
-            strClosed = true;
-        } else if (c == '\n' || peek == '\n') {
-            validString = false;
-            break;
+        // Ignore escaped quote and escaped backslash
+        if (c[1] == '"' || c[1] == '\\') {
+            c += 2;
+        } else {
+            c++;
         }
-        outSize++;
     }
-
-    return validString;
 }
 
 /**
- * Scans a number
+ * Scans a number. The Cursor will point behind the number afterwards or at the
+ * first unexpected char
  * @param outSize [out] Size of the number string
+ * @param isFloat [out] Is set to true if the number is a float
  * @return On valid number retuns true otherwise false
  */
 bool Scanner::scanNumber(uint32_t& outSize, bool& isFloat) {
     bool validNumber = true;
-
-    // Get first char and peek
-    char c = ' ';
-    Src->getChar(Cursor, c);
-    char peek = peekChar();
+    const uint8_t* c = Cursor;
 
     // Check if number has hex prefix 0x
-    if (c == '0' && peek == 'x') {
-        outSize += 2;
-        incCursor();
-
-        // Parse hex number until terminated by [ \n\t,\r\]]
-        while (peek != 0 && peek != ' ' && peek != '\n' && peek != '\t' &&
-               peek != ',' && peek != '\r' && peek != ']') {
-            c = eatChar();
-            // Check for valid hex number [0-9a-fA-F]+
-            if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') ||
-                (c >= 'A' && c <= 'F')) {
-                outSize++;
-                peek = peekChar();
-            } else {
+    if (c[0] == '0' && c[1] == 'x') {
+        c += 2;
+        // Parse hex number [0-9a-fA-F]+ until terminated by [\0 \n\t,\r\]]
+        do {
+            if (!hasFlag(*c, CHAR_FLAG_HEX)) {
                 validNumber = false;
                 break;
             }
-        }
+            c++;
+        } while (!hasFlag(*c, CHAR_FLAG_NUMBER_END));
 
     } else {
-        bool hasExponent = false;
-        // Parse dec or float number until terminated by [ \n\t,\r\]]
-        while (validNumber) {
-            // Valid dec or float number [0-9]+
-            if (c >= '0' && c <= '9') {
-                outSize++;
-            } else if (c == '.') {
-                // If number contains comma '.' number is a float. If number
-                // contains more than one comma '.' number is invalid
+        // Parse dec or float number until terminated by [\0 \n\t,\r\]]
+        while (true) {
+            if (hasFlag(*c, CHAR_FLAG_DIGIT)) {
+                c++;
+            } else if (*c == '.') {
+                // If number contains a point '.' it is a float. If number
+                // contains more than one point '.' number is invalid
                 if (isFloat) {
                     validNumber = false;
                     break;
                 }
-
                 isFloat = true;
-                outSize++;
-            } else if (c == 'e' || c == 'E') {
-                // If preceding number have a comma '.' in it number is a float
-                // otherwise an integer
+                c++;
+            } else if (*c == 'e' || *c == 'E') {
+                // If preceding number has a point '.' in it the number is a
+                // float otherwise it is invalid
                 if (!isFloat) {
                     validNumber = false;
                     break;
                 }
 
-                // e might be followed by + or - sign
-                if (peek == '+' || peek == '-') {
-                    c = eatChar();
-                    outSize++;
+                // e might be followed by + or - sign which has to be followed
+                // by another char of the number
+                if (c[1] == '+' || c[1] == '-') {
+                    c += 2;
+                    continue;
                 }
-                hasExponent = true;
-                outSize++;
+                c++;
             } else {
                 validNumber = false;
                 break;
             }
 
-            if (peek == 0 || peek == ' ' || peek == '\n' || peek == '\t' ||
-                peek == ',' || peek == '\r' || peek == ']') {
+            if (hasFlag(*c, CHAR_FLAG_NUMBER_END)) {
                 break;
             }
-            c = eatChar();
-            peek = peekChar();
         }
     }
 
+    outSize = c - Cursor;
+    Cursor = c;
     return validNumber;
 }
 
@@ -320,24 +375,18 @@ bool Scanner::scanNumber(uint32_t& outSize, bool& isFloat) {
  * @param tag  [out] Pointer to tag information can be nullptr
  * @return Type of token
  */
-TokenType Scanner::identifyWord(std::string& word, uint8_t* tag) {
-    TokenType type = TokenType::IDENTIFIER;
-    uint8_t tmpTag = 0;
-    if (isInstruction(word, tmpTag)) {
-        type = TokenType::INSTRUCTION;
-    } else if (isTypeInfo(word, tmpTag)) {
-        type = TokenType::TYPE_INFO;
-    } else if (isRegister(word, tmpTag)) {
-        type = TokenType::REGISTER_DEFINITION;
+TokenType Scanner::identifyWord(std::string_view word, uint8_t* tag) {
+    // If the token is not an instruction, type info or register def then it
+    // must be an identifier
+    const KeywordEntry* keyword = findKeyword(word.data(), word.size());
+    if (keyword == nullptr) {
+        return TokenType::IDENTIFIER;
     }
 
     if (tag != nullptr) {
-        *tag = tmpTag;
+        *tag = keyword->Tag;
     }
-
-    // If the token is not an instruction, type info or register def then it
-    // must be an identifier which is the default value of type
-    return type;
+    return keyword->Type;
 }
 
 /**
@@ -345,213 +394,359 @@ TokenType Scanner::identifyWord(std::string& word, uint8_t* tag) {
  * @return On success returns true otherwise false
  */
 bool Scanner::scanSource() {
+    bool validSource = scanTokens(SIZE_MAX);
+
+    // Add end of file token
+    Tokens->push(TokenType::END_OF_FILE, 0, Cursor - Start - 1, 1);
+
+    Done = true;
+    Valid = validSource;
+    return validSource;
+}
+
+/**
+ * Checks if a token is a number and has a value in the literal table
+ * @param type Token type
+ * @return If token is an integer or float number returns true otherwise false
+ */
+static bool isNumber(TokenType type) {
+    return type == TokenType::INTEGER_NUMBER || type == TokenType::FLOAT_NUMBER;
+}
+
+/**
+ * Returns the next token without consuming it. If all tokens of the current
+ * batch have been consumed the next batch is scanned
+ * @return Next token, at the end of the source file always the end of file
+ * token
+ */
+Token Scanner::peek() {
+    if (ReadIndex == Tokens->size()) {
+        if (Done) {
+            return Tokens->get(Tokens->size() - 1);
+        }
+        scanBatch();
+    }
+
+    Token tok = Tokens->get(ReadIndex);
+    if (isNumber(tok.Type)) {
+        tok.Value = Tokens->getLiteral(ReadLiteral);
+    }
+    return tok;
+}
+
+/**
+ * Returns the next token and consumes it
+ * @return Next token, at the end of the source file always the end of file
+ * token
+ */
+Token Scanner::next() {
+    Token tok = peek();
+    if (ReadIndex < Tokens->size()) {
+        ReadIndex++;
+        if (isNumber(tok.Type)) {
+            ReadLiteral++;
+        }
+    }
+    return tok;
+}
+
+/**
+ * Scans the rest of the source file without keeping the tokens. All
+ * diagnostics of the scanner have been printed afterwards
+ * @return If the whole source file is valid returns true otherwise false
+ */
+bool Scanner::finishSource() {
+    while (!Done) {
+        scanBatch();
+    }
+    return Valid;
+}
+
+/**
+ * Replaces the token stream with the next batch of up to STREAM_SCAN_BATCH
+ * tokens. The end of file token is added to the last batch
+ */
+void Scanner::scanBatch() {
+    if (!Tokens->empty()) {
+        PrevType = Tokens->getType(Tokens->size() - 1);
+    }
+    Tokens->clear();
+    ReadIndex = 0;
+    ReadLiteral = 0;
+
+    if (!scanTokens(STREAM_SCAN_BATCH)) {
+        Valid = false;
+    }
+
+    // The batch is only cut short at the end of the source file
+    if (Cursor >= End) {
+        Tokens->push(TokenType::END_OF_FILE, 0, Cursor - Start - 1, 1);
+        Done = true;
+    }
+}
+
+/**
+ * Scans the source file on multiple threads. The source file is split into
+ * chunks behind new lines so that no token crosses a chunk border. Every chunk
+ * is scanned on its own thread assuming that it does not start inside of a
+ * multiline comment, only if this turns out to be wrong the chunk is scanned
+ * again. The output tokens and diagnostics are the same as from scanSource().
+ * Source files which are too small to be split are not scanned here, their
+ * tokens are scanned on demand by next()
+ * @param threadCount Maximum amount of threads to use
+ * @return On success returns true otherwise false
+ */
+bool Scanner::scanSourceParallel(uint32_t threadCount) {
+    uint32_t size = Src->getSize();
+    uint32_t chunkCount = std::min(threadCount, size / PARALLEL_SCAN_MIN_CHUNK);
+    if (chunkCount <= 1) {
+        return true;
+    }
+
+    // Split source file into chunks of roughly the same size. There are less
+    // chunks if the source file has only a few very long lines
+    std::vector<ScanChunk> chunks(chunkCount);
+    uint32_t chunkBegin = 0;
+    size_t usedChunks = 0;
+    while (chunkBegin < size) {
+        uint32_t chunkEnd = size;
+        if (usedChunks + 1 < chunkCount) {
+            uint32_t split = size / chunkCount * (usedChunks + 1);
+            split = std::max(chunkBegin, split);
+            chunkEnd = findByte(&Start[split], End, '\n') - Start + 1;
+            chunkEnd = std::min(chunkEnd, size);
+        }
+
+        chunks[usedChunks].Begin = chunkBegin;
+        chunks[usedChunks].End = chunkEnd;
+        chunkBegin = chunkEnd;
+        usedChunks++;
+    }
+    chunks.resize(usedChunks);
+
+    // Scan the first chunk on this thread and all others on worker threads
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < chunks.size(); i++) {
+        workers.emplace_back(&Scanner::scanChunk, this, &chunks[i]);
+    }
+    scanChunk(&chunks[0]);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    // Merge the chunks in order
     bool validSource = true;
-    char currChar = 0;
-    Src->getChar(Cursor, currChar);
+    bool inComment = false;
+    for (ScanChunk& chunk : chunks) {
+        if (inComment) {
+            // The chunk starts inside of a multiline comment. Scan it again
+            // directly into the output which also prints the diagnostics
+            Scanner rescan{Src, Tokens, chunk.Begin, chunk.End};
+            rescan.InBlockComment = true;
+            if (!rescan.scanTokens(SIZE_MAX)) {
+                validSource = false;
+            }
+            chunk.InBlockComment = rescan.InBlockComment;
+            chunk.FoundZero = rescan.FoundZero;
+            chunk.Stop = rescan.Cursor - Start;
+        } else {
+            for (const ScanError& err : chunk.Errors) {
+                printError(Src, err.Index, err.Size, err.Msg);
+            }
+            Tokens->append(chunk.Tokens);
+            if (!chunk.Valid) {
+                validSource = false;
+            }
+        }
 
-    while (currChar != 0) {
+        Cursor = &Start[chunk.Stop];
+        inComment = chunk.InBlockComment;
+        // Nothing behind a zero byte is part of the source file
+        if (chunk.FoundZero) {
+            break;
+        }
+    }
+
+    // Add end of file token
+    Tokens->push(TokenType::END_OF_FILE, 0, Cursor - Start - 1, 1);
+
+    Done = true;
+    Valid = validSource;
+    return validSource;
+}
+
+/**
+ * Scans a chunk of the source file assuming it does not start inside of a
+ * multiline comment. This is run on a worker thread
+ * @param chunk [in/out] Chunk whose Begin and End are set
+ */
+void Scanner::scanChunk(ScanChunk* chunk) {
+    Scanner scan{Src, &chunk->Tokens, chunk->Begin, chunk->End};
+    scan.Errors = &chunk->Errors;
+    chunk->Valid = scan.scanTokens(SIZE_MAX);
+    chunk->InBlockComment = scan.InBlockComment;
+    chunk->FoundZero = scan.FoundZero;
+    chunk->Stop = scan.Cursor - Start;
+}
+
+/**
+ * Scans tokens from the Cursor up to End
+ * @param maxTokens The scanner stops early once the token stream contains this
+ * many tokens
+ * @return On success returns true otherwise false
+ */
+bool Scanner::scanTokens(size_t maxTokens) {
+    bool validSource = true;
+
+    // A chunk can start inside of a multiline comment of the previous chunk
+    if (InBlockComment) {
+        skipCommentBody();
+    }
+
+    while (Cursor < End && Tokens->size() < maxTokens) {
         // Take a snapshot of the current token position before parsing
         // further and increasing the cursor
-        uint32_t tokPos = Cursor;
-        uint32_t tokLineRow = CursorLineRow;
-        uint32_t tokLineColumn = CursorLineColumn;
+        uint32_t tokPos = Cursor - Start;
 
-        // Check if char is a valid word start [a-zA-Z_]
-        if ((currChar >= 'A' && currChar <= 'Z') ||
-            (currChar >= 'a' && currChar <= 'z') || currChar == '_') {
+        switch (CHAR_CLASSES[*Cursor]) {
+        case CharClass::LETTER:
+        case CharClass::UNDERSCORE: {
             // Get complete word
             uint32_t wordSize = 0;
             bool validWord = scanWord(wordSize);
             if (!validWord) {
                 validSource = false;
-                printError(Src, tokPos, wordSize, tokLineRow, tokLineColumn,
-                           "Unexpected character in identifer");
+                reportError(tokPos, wordSize,
+                            "Unexpected character in identifer");
                 skipLine();
-                currChar = eatChar();
-                continue;
+                break;
             }
 
-            // Get word as string
-            std::string token{};
-            Src->getSubStr(tokPos, wordSize, token);
-
             // Get word type and add it to tokens array
             uint8_t tag = 0;
-            TokenType type = identifyWord(token, &tag);
-            Tokens->emplace_back(type, tokPos, wordSize, tokLineRow,
-                                 tokLineColumn, tag);
-            currChar = eatChar();
-
-        } else if (currChar >= '0' && currChar <= '9') {
+            TokenType type =
+                identifyWord(Src->getView(tokPos, wordSize), &tag);
+            Tokens->push(type, tag, tokPos, wordSize);
+        } break;
+        case CharClass::DIGIT: {
             uint32_t numSize = 0;
             bool isFloat = false;
             bool validNum = scanNumber(numSize, isFloat);
             if (!validNum) {
                 validSource = false;
-                printError(Src, tokPos, numSize, tokLineRow, tokLineColumn,
-                           "Unexpected character in number");
+                reportError(tokPos, numSize, "Unexpected character in number");
                 skipLine();
-                currChar = eatChar();
-                continue;
+                break;
             }
 
+            // Decode the number while it is still in the cache. If it is out
+            // of range the parser reports it once it knows the context
+            const uint8_t* numStart = &Start[tokPos];
             TokenType type = TokenType::INTEGER_NUMBER;
+            Literal value;
+            bool inRange = false;
             if (isFloat) {
                 type = TokenType::FLOAT_NUMBER;
+                inRange = decodeFloat(numStart, Cursor, value.Float);
+            } else {
+                inRange = decodeInt(numStart, Cursor, value.Int);
             }
-            Tokens->emplace_back(type, tokPos, numSize, tokLineRow,
-                                 tokLineColumn, 0);
-            currChar = eatChar();
 
-        } else if (currChar == ' ' || currChar == '\t') {
-            // Skip whitespace
-            currChar = eatChar();
-        } else {
-            switch (currChar) {
-            case '+':
-                Tokens->emplace_back(TokenType::PLUS_SIGN, Cursor, 1,
-                                     CursorLineRow, CursorLineColumn, 0);
-                break;
-            case '-':
-                Tokens->emplace_back(TokenType::MINUS_SIGN, Cursor, 1,
-                                     CursorLineRow, CursorLineColumn, 0);
-                break;
-            case '*':
-                Tokens->emplace_back(TokenType::ASTERISK, Cursor, 1,
-                                     CursorLineRow, CursorLineColumn, 0);
-                break;
-            case ',':
-                Tokens->emplace_back(TokenType::COMMA, Cursor, 1, CursorLineRow,
-                                     CursorLineColumn, 0);
-                break;
-            case '[':
-                Tokens->emplace_back(TokenType::LEFT_SQUARE_BRACKET, Cursor, 1,
-                                     CursorLineRow, CursorLineColumn, 0);
-                break;
-            case ']':
-                Tokens->emplace_back(TokenType::RIGHT_SQUARE_BRACKET, Cursor, 1,
-                                     CursorLineRow, CursorLineColumn, 0);
-                break;
-            case '{':
-                Tokens->emplace_back(TokenType::LEFT_CURLY_BRACKET, Cursor, 1,
-                                     CursorLineRow, CursorLineColumn, 0);
-                break;
-            case '}':
-                Tokens->emplace_back(TokenType::RIGHT_CURLY_BRACKET, Cursor, 1,
-                                     CursorLineRow, CursorLineColumn, 0);
-                break;
-            case ':':
-                Tokens->emplace_back(TokenType::COLON, Cursor, 1, CursorLineRow,
-                                     CursorLineColumn, 0);
-                break;
-            case '=':
-                Tokens->emplace_back(TokenType::EQUALS_SIGN, Cursor, 1,
-                                     CursorLineRow, CursorLineColumn, 0);
+            // The width of a float is checked right away as well, the parser
+            // only compares it with the type of the value
+            uint8_t tag = 0;
+            if (!inRange) {
+                tag = TAG_LITERAL_OUT_OF_RANGE;
+            } else if (isFloat && value.Float > FLT_MAX) {
+                tag = TAG_LITERAL_EXCEEDS_F32;
+            }
+            Tokens->pushLiteral(type, tag, tokPos, numSize, value);
+        } break;
+        case CharClass::BLANK:
+            // Skip the whole run of whitespace at once
+            Cursor = skipBlanks(&Cursor[1], End);
+            break;
+        case CharClass::PUNCTUATOR:
+            Tokens->push(PUNCTUATOR_TYPES[*Cursor], 0, tokPos, 1);
+            Cursor++;
+            break;
+        case CharClass::QUOTE: {
+            uint32_t strSize = 0;
+            bool validString = scanString(strSize);
+            if (!validString) {
+                validSource = false;
+                reportError(tokPos, strSize, "Unexpected character in string");
+                skipLine();
                 break;
-            case '"': {
-                uint32_t strSize = 0;
-                bool validString = scanString(strSize);
-                if (!validString) {
-                    validSource = false;
-                    printError(Src, tokPos, strSize, tokLineRow, tokLineColumn,
-                               "Unexpected character in string");
-                    skipLine();
-                    currChar = eatChar();
-                    continue;
-                }
-                Tokens->emplace_back(TokenType::STRING, tokPos, strSize,
-                                     tokLineRow, tokLineColumn, 0);
+            }
+            Tokens->push(TokenType::STRING, 0, tokPos, strSize);
+        } break;
+        case CharClass::AT_SIGN: {
+            // Start at 1 to include @ sign
+            uint32_t labelSize = 1;
+            Cursor++;
+            bool validWord = scanWord(labelSize);
+            if (!validWord) {
+                validSource = false;
+                reportError(tokPos, labelSize,
+                            "Unexpected character in label identifer");
+                skipLine();
                 break;
             }
-            case '@': {
-                // Start at 1 to include @ sign
-                uint32_t labelSize = 1;
-                incCursor();
-                bool validWord = scanWord(labelSize);
-                if (!validWord) {
-                    validSource = false;
-                    printError(Src, tokPos, labelSize, tokLineRow,
-                               tokLineColumn,
-                               "Unexpected character in label identifer");
-                    skipLine();
-                    currChar = eatChar();
-                    continue;
-                }
 
-                // Get label as string
-                std::string label{};
-                Src->getSubStr(tokPos, labelSize, label);
-
-                // Get word type and add it to tokens array
-                TokenType type = identifyWord(label, nullptr);
-                if (type != TokenType::IDENTIFIER) {
-                    validSource = false;
-                    printError(Src, tokPos, labelSize, tokLineRow,
-                               tokLineColumn,
-                               "Keyword inside label identifier");
-                    skipLine();
-                    currChar = eatChar();
-                    continue;
-                }
-
-                Tokens->emplace_back(TokenType::LABEL_DEF, tokPos, labelSize,
-                                     tokLineRow, tokLineColumn, 0);
-            } break;
-            case '\r':
-                // Skip CR
-                break;
-            case '\n': {
-                // Only add EOL tokens once in a row
-                Token* last = nullptr;
-                if (!Tokens->empty()) {
-                    last = &Tokens->back();
-                }
-                if (last != nullptr && last->Type != TokenType::EOL) {
-                    Tokens->emplace_back(TokenType::EOL, Cursor, 1,
-                                         CursorLineRow, CursorLineColumn, 0);
-                }
-                incLineRow();
-            } break;
-            case '/': {
-                char c = ' ';
-                char peek = peekChar();
-                // Single line comment
-                if (peek == '/') {
-                    incCursor();
-                    peek = peekChar();
-                    while (peek != 0 && peek != '\n') {
-                        incCursor();
-                        peek = peekChar();
-                    }
-                    // Multiline comment
-                } else if (peek == '*') {
-                    incCursor();
-                    c = eatChar();
-                    peek = peekChar();
-                    while (c != '*' && peek != '\\' && peek != 0) {
-                        c = eatChar();
-                        peek = peekChar();
-                    }
-                    incCursor();
-                } else {
-                    validSource = false;
-                    skipLine();
-                }
-            } break;
-            default:
-                printError(Src, tokPos, 1, tokLineRow, tokLineColumn,
-                           "Unexpected character");
-                skipLine();
+            // Get word type and add it to tokens array
+            TokenType type =
+                identifyWord(Src->getView(tokPos, labelSize), nullptr);
+            if (type != TokenType::IDENTIFIER) {
                 validSource = false;
+                reportError(tokPos, labelSize,
+                            "Keyword inside label identifier");
+                skipLine();
                 break;
             }
-            currChar = eatChar();
+
+            Tokens->push(TokenType::LABEL_DEF, 0, tokPos, labelSize);
+        } break;
+        case CharClass::CARRIAGE_RETURN:
+            // Skip CR
+            Cursor++;
+            break;
+        case CharClass::NEW_LINE: {
+            // Only add EOL tokens once in a row. The last token can be part of
+            // the previous batch
+            TokenType last = PrevType;
+            if (!Tokens->empty()) {
+                last = Tokens->getType(Tokens->size() - 1);
+            }
+            if (last != TokenType::EOL) {
+                Tokens->push(TokenType::EOL, 0, tokPos, 1);
+            }
+            Cursor++;
+        } break;
+        case CharClass::SLASH:
+            // Single line comment
+            if (Cursor[1] == '/') {
+                skipLineComment();
+                // Multiline comment
+            } else if (Cursor[1] == '*') {
+                skipBlockComment();
+            } else {
+                validSource = false;
+                skipLine();
+            }
+            break;
+        case CharClass::END:
+            // A zero byte ends the source file early
+            FoundZero = true;
+            End = Cursor;
+            break;
+        default:
+            reportError(tokPos, 1, "Unexpected character");
+            skipLine();
+            validSource = false;
+            break;
         }
     }
 
-    // Add end of file token
-    Tokens->emplace_back(TokenType::END_OF_FILE, Cursor - 1, 1, CursorLineRow,
-                         CursorLineColumn, 0);
-
     return validSource;
 }
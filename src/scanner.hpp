@@ -17,40 +17,105 @@
 #pragma once
 #include "source.hpp"
 #include "token.hpp"
+#include <cstddef>
 #include <cstdint>
-#include <string>
+#include <string_view>
 #include <vector>
 
 /**
- * Scans a source file and outputs an array of tokens
+ * Minimum size of a chunk of the source file which is scanned on its own thread
+ */
+constexpr uint32_t PARALLEL_SCAN_MIN_CHUNK = 1024 * 1024;
+
+/**
+ * Maximum amount of tokens which are scanned at once when the tokens are pulled
+ * with next(). The token stream is reused for every batch
+ */
+constexpr uint32_t STREAM_SCAN_BATCH = 4096;
+
+/**
+ * Diagnostic which has been found while scanning a chunk. It is printed once
+ * all chunks in front of it are merged
+ */
+struct ScanError {
+    uint32_t Index;
+    uint32_t Size;
+    const char* Msg;
+};
+
+/**
+ * Range of the source file which is scanned on its own thread and its results
+ */
+struct ScanChunk {
+    /** Index of the first char of the chunk */
+    uint32_t Begin = 0;
+    /** Index behind the last char of the chunk */
+    uint32_t End = 0;
+    /** Index where the scanner stopped */
+    uint32_t Stop = 0;
+    TokenStream Tokens;
+    std::vector<ScanError> Errors;
+    bool Valid = true;
+    /** Chunk ends inside of a multiline comment */
+    bool InBlockComment = false;
+    /** Chunk contains a zero byte which ends the source file early */
+    bool FoundZero = false;
+};
+
+/**
+ * Scans a source file into a token stream. The tokens are either scanned all
+ * at once or pulled one by one with next() which scans them in small batches
  */
 class Scanner {
   public:
-    Scanner(SourceFile* src, std::vector<Token>* outTokens);
+    Scanner(SourceFile* src, TokenStream* outTokens);
     bool scanSource();
+    bool scanSourceParallel(uint32_t threadCount);
+    Token next();
+    Token peek();
+    bool finishSource();
 
   private:
     /** Non owning pointer to the source file */
     SourceFile* Src = nullptr;
-    /** Non owning pointer to the output token vector */
-    std::vector<Token>* Tokens = nullptr;
-    /** The current index into the source file */
-    uint32_t Cursor = 0;
-    /** The current line row at the cursor poition */
-    uint32_t CursorLineRow = 1;
-    /** The current line column at the cursor poition */
-    uint32_t CursorLineColumn = 1;
-    void incLineRow();
-    void incCursor();
-    char eatChar();
-    char peekChar();
-    void skipChar(uint32_t count);
+    /** Non owning pointer to the output token stream */
+    TokenStream* Tokens = nullptr;
+    /** Pointer to the first char of the source file */
+    const uint8_t* Start = nullptr;
+    /** Pointer behind the last char of the source file */
+    const uint8_t* End = nullptr;
+    /** Pointer to the current char */
+    const uint8_t* Cursor = nullptr;
+    /** If not nullptr diagnostics are collected instead of printed */
+    std::vector<ScanError>* Errors = nullptr;
+    /** Is set if the scanner stopped inside of a multiline comment */
+    bool InBlockComment = false;
+    /** Is set if the scanner stopped at a zero byte in front of End */
+    bool FoundZero = false;
+    /** Is set once the end of file token has been added */
+    bool Done = false;
+    /** Is cleared once the scanner found an invalid token */
+    bool Valid = true;
+    /** Position of the next token handed out by next() */
+    size_t ReadIndex = 0;
+    /** Position of the next number token value handed out by next() */
+    size_t ReadLiteral = 0;
+    /** Type of the last token of the previous batch */
+    TokenType PrevType = TokenType::EOL;
+    Scanner(SourceFile* src,
+            TokenStream* outTokens,
+            uint32_t begin,
+            uint32_t end);
+    bool scanTokens(size_t maxTokens);
+    void scanBatch();
+    void scanChunk(ScanChunk* chunk);
+    void reportError(uint32_t index, uint32_t size, const char* msg);
     void skipLine();
+    void skipLineComment();
+    void skipBlockComment();
+    void skipCommentBody();
     bool scanWord(uint32_t& outSize);
     bool scanString(uint32_t& outSize);
     bool scanNumber(uint32_t& outSize, bool& isFloat);
-    static TokenType identifyWord(std::string& word, uint8_t* tag);
-    static bool isRegister(std::string& token, uint8_t& tag);
-    static bool isTypeInfo(std::string& token, uint8_t& tag);
-    static bool isInstruction(std::string& token, uint8_t& tag);
+    static TokenType identifyWord(std::string_view word, uint8_t* tag);
 };
@@ -15,13 +15,39 @@
 // ======================================================================== //
 
 #include "source.hpp"
+#include "byteSearch.hpp"
+#include "fileMap.hpp"
+#include <algorithm>
+#include <cstring>
 
 /**
- * Constructs a new SourceFile
- * @param data Pointer to file buffer
+ * Constructs a new SourceFile with an uninitialized file buffer which has to be
+ * filled through getData()
  * @param size Size of file buffer
  */
-SourceFile::SourceFile(uint8_t* data, uint32_t size) : Data(data), Size(size) {}
+SourceFile::SourceFile(uint32_t size)
+    : Data(new uint8_t[size + SOURCE_PADDING]), Size(size) {
+    std::memset(&Data[size], 0, SOURCE_PADDING);
+}
+
+/**
+ * Constructs a new SourceFile which takes ownership of a file mapping
+ * @param mappedData Pointer to a file mapped by mapFile() with SOURCE_PADDING
+ * @param size Size of the mapped file
+ */
+SourceFile::SourceFile(uint8_t* mappedData, uint32_t size)
+    : Data(mappedData), Mapped(true), Size(size) {}
+
+/**
+ * SourceFile destructor
+ */
+SourceFile::~SourceFile() {
+    if (Mapped) {
+        unmapFile(Data, Size, SOURCE_PADDING);
+    } else {
+        delete[] Data;
+    }
+}
 
 /**
  * Gets the size of file buffer
@@ -32,11 +58,11 @@ uint32_t SourceFile::getSize() {
 }
 
 /**
- * Gets the raw file buffer
+ * Gets the raw file buffer. The buffer of a mapped file is read only
  * @return Pointer to file buffer
  */
 uint8_t* SourceFile::getData() {
-    return Data.get();
+    return Data;
 }
 
 /**
@@ -47,7 +73,7 @@ uint8_t* SourceFile::getData() {
  */
 bool SourceFile::getChar(uint32_t index, char& c) {
     if (index < Size) {
-        c = Data.get()[index];
+        c = Data[index];
         return true;
     } else {
         return false;
@@ -55,32 +81,24 @@ bool SourceFile::getChar(uint32_t index, char& c) {
 }
 
 /**
- * Gets a substring of the file buffer
+ * Gets a view of a substring of the file buffer without copying it
  * @param index Index into file buffer
  * @param size Size of substring
- * @param out [out] String which will be filled with the substring
- * @return On success returns true otherwise false
+ * @return View of the substring or an empty view if the substring is not
+ * inside of the file buffer
  */
-bool SourceFile::getSubStr(uint32_t index, uint32_t size, std::string& out) {
-    if (index < Size && index + size < Size) {
-        out.clear();
-        out.reserve(size);
-        char c;
-        for (auto i = 0; i < size; i++) {
-            getChar(index + i, c);
-            out.push_back(c);
-        }
-        return true;
-    } else {
-        return false;
+std::string_view SourceFile::getView(uint32_t index, uint32_t size) {
+    if (index > Size || size > Size - index) {
+        return {};
     }
+    return std::string_view{(const char*)&Data[index], size};
 }
 
 /**
  * Gets a complete source file line of the given index
  * @param index Index into file buffer
  * @param out [out] String which will be filled with the line
- * @param lineIndex [out] Contains the line number
+ * @param lineIndex [out] Index of the first char of the line
  * @return On success returns true otherwise false
  */
 bool SourceFile::getLine(uint32_t index,
@@ -90,27 +108,66 @@ bool SourceFile::getLine(uint32_t index,
         return false;
     }
 
-    // Non owning pointer
-    uint8_t* DataPtr = Data.get();
-
-    // Find the begining of the line
-    bool foundSOL = false;
-    while (!foundSOL && (int32_t)index - 1 > 0) {
-        if (DataPtr[index - 1] == '\n') {
-            foundSOL = true;
-        } else {
-            index--;
-        }
-    }
-    lineIndex = index;
-
-    // Parse the whole line
-    uint8_t c = DataPtr[index];
-    while (c != '\n' && index < Size) {
-        index++;
-        out.push_back(c);
-        c = DataPtr[index];
+    uint32_t row = getLineNumber(index);
+    lineIndex = LineStarts[row - 1];
+
+    // The line ends in front of the next line start or at the end of file
+    uint32_t lineEnd = Size;
+    if (row < LineStarts.size()) {
+        lineEnd = LineStarts[row] - 1;
     }
 
+    const char* data = (const char*)Data;
+    out.append(&data[lineIndex], lineEnd - lineIndex);
     return true;
 }
+
+/**
+ * Gets the line number of a position in the file buffer
+ * @param index Index into file buffer
+ * @return Line number starting at 1
+ */
+uint32_t SourceFile::getLineNumber(uint32_t index) {
+    buildLineIndex();
+
+    // Every line starting at or in front of the index is counted
+    auto next = std::upper_bound(LineStarts.begin(), LineStarts.end(), index);
+    return next - LineStarts.begin();
+}
+
+/**
+ * Gets the line row and line column of a position in the file buffer. Both
+ * start at 1
+ * @param index Index into file buffer
+ * @param row [out] Line row
+ * @param column [out] Line column
+ */
+void SourceFile::getPosition(uint32_t index,
+                             uint32_t& row,
+                             uint32_t& column) {
+    if (index > Size) {
+        index = Size;
+    }
+
+    row = getLineNumber(index);
+    column = index - LineStarts[row - 1] + 1;
+}
+
+/**
+ * Builds the line start table if it has not been built yet
+ */
+void SourceFile::buildLineIndex() {
+    if (!LineStarts.empty()) {
+        return;
+    }
+
+    const uint8_t* data = Data;
+    const uint8_t* end = &data[Size];
+    LineStarts.push_back(0);
+
+    const uint8_t* eol = findByte(data, end, '\n');
+    while (eol != end) {
+        LineStarts.push_back(eol - data + 1);
+        eol = findByte(eol + 1, end, '\n');
+    }
+}
@@ -16,25 +16,47 @@
 
 #pragma once
 #include <cstdint>
-#include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Amount of zero bytes which follow the content of every source file buffer.
+ * The scanner stops at the first zero byte which lets it run over the buffer
+ * without checking the bounds on every char
+ */
+constexpr uint32_t SOURCE_PADDING = 32;
 
 /**
  * Represents a source file
  */
 class SourceFile {
   public:
-    SourceFile(uint8_t* data, uint32_t size);
+    SourceFile(uint32_t size);
+    SourceFile(uint8_t* mappedData, uint32_t size);
+    SourceFile(const SourceFile&) = delete;
+    SourceFile& operator=(const SourceFile&) = delete;
+    ~SourceFile();
     uint32_t getSize();
     // TODO: Deprecate this
     uint8_t* getData();
     bool getChar(uint32_t index, char& c);
-    bool getSubStr(uint32_t index, uint32_t size, std::string& out);
+    std::string_view getView(uint32_t index, uint32_t size);
     bool getLine(uint32_t index, std::string& out, uint32_t& lineIndex);
+    uint32_t getLineNumber(uint32_t index);
+    void getPosition(uint32_t index, uint32_t& row, uint32_t& column);
 
   private:
-    /** Raw file buffer */
-    std::unique_ptr<uint8_t> Data;
+    /** Raw file buffer followed by SOURCE_PADDING zero bytes */
+    uint8_t* Data = nullptr;
+    /** Is set if Data is a file mapping instead of an allocated buffer */
+    bool Mapped = false;
     /** File buffer size */
     const uint32_t Size = 0;
+    /**
+     * Index of the first char of every line, sorted ascending. It is only
+     * needed for diagnostics and therefore built on first use
+     */
+    std::vector<uint32_t> LineStarts;
+    void buildLineIndex();
 };
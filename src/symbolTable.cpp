@@ -0,0 +1,132 @@
+// ======================================================================== //
+// Copyright 2021 Michel Fäh
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ======================================================================== //
+
+
+#include "symbolTable.hpp"
+
+/**
+ * Hashes a symbol name (32-bit FNV-1a)
+ * @param name Symbol name
+ * @return Hash value
+ */
+static uint32_t hashName(std::string_view name) {
+    uint32_t hash = 0x811C9DC5;
+    for (char c : name) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 0x01000193;
+    }
+    return hash;
+}
+
+/**
+ * Constructs an empty SymbolTable
+ */
+SymbolTable::SymbolTable() : Slots(SYMBOL_TABLE_MIN_SLOTS, SYMBOL_UNDEFINED) {}
+
+/**
+ * Returns the symbol id of a name and creates a new symbol if the name has not
+ * been interned before
+ * @param name Symbol name, it must stay valid as long as the table is used
+ * @return Symbol id
+ */
+uint32_t SymbolTable::intern(std::string_view name) {
+    uint32_t hash = hashName(name);
+    uint32_t slot = findSlot(name, hash);
+    if (Slots[slot] != SYMBOL_UNDEFINED) {
+        return Slots[slot];
+    }
+
+    uint32_t id = Symbols.size();
+    Symbol& sym = Symbols.emplace_back();
+    sym.Name = name;
+    sym.Hash = hash;
+    Slots[slot] = id;
+
+    // Keep the load factor at or below 1/2 so probe sequences stay short
+    if (Symbols.size() * 2 > Slots.size()) {
+        grow();
+    }
+    return id;
+}
+
+/**
+ * Looks up a name without interning it
+ * @param name Symbol name
+ * @return Symbol id or SYMBOL_UNDEFINED if the name has not been interned
+ */
+uint32_t SymbolTable::find(std::string_view name) const {
+    return Slots[findSlot(name, hashName(name))];
+}
+
+/**
+ * Returns a symbol
+ * @param id Symbol id returned by intern
+ * @return Reference to the symbol, it is invalidated by the next intern
+ */
+Symbol& SymbolTable::get(uint32_t id) {
+    return Symbols[id];
+}
+
+/**
+ * Returns a symbol
+ * @param id Symbol id returned by intern
+ * @return Reference to the symbol, it is invalidated by the next intern
+ */
+const Symbol& SymbolTable::get(uint32_t id) const {
+    return Symbols[id];
+}
+
+/**
+ * Returns the amount of interned symbols
+ * @return Amount of symbols
+ */
+size_t SymbolTable::size() const {
+    return Symbols.size();
+}
+
+/**
+ * Finds the slot which holds a name or the empty slot where it would be
+ * inserted
+ * @param name Symbol name
+ * @param hash Hash of the name
+ * @return Slot index
+ */
+uint32_t SymbolTable::findSlot(std::string_view name, uint32_t hash) const {
+    uint32_t mask = Slots.size() - 1;
+    uint32_t slot = hash & mask;
+    while (Slots[slot] != SYMBOL_UNDEFINED) {
+        const Symbol& sym = Symbols[Slots[slot]];
+        if (sym.Hash == hash && sym.Name == name) {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/**
+ * Doubles the amount of slots and reinserts every symbol
+ */
+void SymbolTable::grow() {
+    Slots.assign(Slots.size() * 2, SYMBOL_UNDEFINED);
+    uint32_t mask = Slots.size() - 1;
+    for (uint32_t id = 0; id < Symbols.size(); id++) {
+        uint32_t slot = Symbols[id].Hash & mask;
+        while (Slots[slot] != SYMBOL_UNDEFINED) {
+            slot = (slot + 1) & mask;
+        }
+        Slots[slot] = id;
+    }
+}
@@ -0,0 +1,68 @@
+// ======================================================================== //
+// Copyright 2021 Michel Fäh
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ======================================================================== //
+
+
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+class LabelDef;
+
+/** Symbol id which does not refer to any symbol */
+constexpr uint32_t SYMBOL_UNDEFINED = UINT32_MAX;
+/** Initial amount of slots of the symbol table, must be a power of two */
+constexpr uint32_t SYMBOL_TABLE_MIN_SLOTS = 1024;
+
+/**
+ * Every distinct label or variable name is a symbol. Labels and variables have
+ * separate namespaces so a symbol can be both at the same time
+ */
+struct Symbol {
+    /** Name of the symbol, this points into the source file */
+    std::string_view Name;
+    /** Hash of the name */
+    uint32_t Hash = 0;
+    /** Index of the variable declaration or SYMBOL_UNDEFINED */
+    uint32_t VarDecl = SYMBOL_UNDEFINED;
+    /** First label definition of this name or nullptr */
+    LabelDef* Label = nullptr;
+    /** Address of the label which is filled out by the generator */
+    uint64_t LabelAddr = 0;
+};
+
+/**
+ * Interns label and variable names to 32-bit symbol ids. The symbols are looked
+ * up with an open addressing hash table so every name is only compared once
+ * when it is interned
+ */
+class SymbolTable {
+  public:
+    SymbolTable();
+    uint32_t intern(std::string_view name);
+    uint32_t find(std::string_view name) const;
+    Symbol& get(uint32_t id);
+    const Symbol& get(uint32_t id) const;
+    size_t size() const;
+
+  private:
+    /** Symbols in the order in which they were interned */
+    std::vector<Symbol> Symbols;
+    /** Symbol id of every slot or SYMBOL_UNDEFINED if the slot is empty */
+    std::vector<uint32_t> Slots;
+    uint32_t findSlot(std::string_view name, uint32_t hash) const;
+    void grow();
+};
@@ -17,19 +17,99 @@
 #include "token.hpp"
 
 /**
- * Constructs a new Token
- * @param type
+ * Appends a token to the stream
+ * @param type Token type
+ * @param tag Contains information which is passed to the parser
  * @param index Token string index in source file
  * @param size Token string size
- * @param lineRow Token string line row in source file
- * @param lineCol Token string line column in source file
+ */
+void TokenStream::push(TokenType type,
+                       uint8_t tag,
+                       uint32_t index,
+                       uint32_t size) {
+    Kinds.push_back(TokenKind{type, tag});
+    Spans.push_back(TokenSpan{index, size});
+}
+
+/**
+ * Appends a number token and its decoded value to the stream
+ * @param type Token type
  * @param tag Contains information which is passed to the parser
+ * @param index Token string index in source file
+ * @param size Token string size
+ * @param value Decoded value of the number
+ */
+void TokenStream::pushLiteral(TokenType type,
+                              uint8_t tag,
+                              uint32_t index,
+                              uint32_t size,
+                              Literal value) {
+    push(type, tag, index, size);
+    Literals.push_back(value);
+}
+
+/**
+ * Appends all tokens and literals of another stream to this one
+ * @param other Token stream to append
+ */
+void TokenStream::append(const TokenStream& other) {
+    Kinds.insert(Kinds.end(), other.Kinds.begin(), other.Kinds.end());
+    Spans.insert(Spans.end(), other.Spans.begin(), other.Spans.end());
+    Literals.insert(Literals.end(), other.Literals.begin(),
+                    other.Literals.end());
+}
+
+/**
+ * Removes all tokens and literals but keeps the allocated memory
+ */
+void TokenStream::clear() {
+    Kinds.clear();
+    Spans.clear();
+    Literals.clear();
+}
+
+/**
+ * Gets the token at the given position
+ * @param index Position of the token in the stream. Must be smaller than size()
+ * @return Token
+ */
+Token TokenStream::get(size_t index) const {
+    const TokenKind& kind = Kinds[index];
+    const TokenSpan& span = Spans[index];
+    return Token{kind.Type, kind.Tag, span.Index, span.Size, Literal{}};
+}
+
+/**
+ * Gets only the type of the token at the given position
+ * @param index Position of the token in the stream. Must be smaller than size()
+ * @return Token type
+ */
+TokenType TokenStream::getType(size_t index) const {
+    return Kinds[index].Type;
+}
+
+/**
+ * Gets the decoded value of a number token
+ * @param index Position of the value in the literal table. The n-th number
+ * token in the stream has its value at position n
+ * @return Decoded value
+ */
+Literal TokenStream::getLiteral(size_t index) const {
+    return Literals[index];
+}
+
+/**
+ * Gets the amount of tokens in the stream
+ * @return Token count
+ */
+size_t TokenStream::size() const {
+    return Kinds.size();
+}
+
+/**
+ * Checks if the stream contains no tokens
+ * @return If there are no tokens returns true otherwise false
  */
-Token::Token(TokenType type,
-             uint32_t index,
-             uint32_t size,
-             uint32_t lineRow,
-             uint32_t lineCol,
-             uint8_t tag)
-    : Type(type), Index(index), Size(size), LineRow(lineRow), LineCol(lineCol),
-      Tag(tag){};
+bool TokenStream::empty() const {
+    return Kinds.empty();
+}
@@ -15,9 +15,11 @@
 // ======================================================================== //
 
 #pragma once
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
-enum class TokenType {
+enum class TokenType : uint8_t {
     IDENTIFIER,
     INSTRUCTION,
     LABEL_DEF,
@@ -40,26 +42,85 @@ enum class TokenType {
     STRING,
 };
 
+/** Tag of a number token whose value does not fit into 64 bits */
+constexpr uint8_t TAG_LITERAL_OUT_OF_RANGE = 0x1;
+/** Tag of a float number token whose value does not fit into 32 bits */
+constexpr uint8_t TAG_LITERAL_EXCEEDS_F32 = 0x2;
+
+/**
+ * Value of a number token which has been decoded by the scanner. The sign is
+ * a token of its own and therefore not part of the value
+ */
+union Literal {
+    uint64_t Int = 0;
+    double Float;
+};
+
+/**
+ * A single token as it is handed out by the TokenStream. The line row and
+ * column are not stored and have to be derived from the Index with the
+ * SourceFile if they are needed
+ */
 struct Token {
-    Token(TokenType type,
-          uint32_t index,
-          uint32_t size,
-          uint32_t lineRow,
-          uint32_t lineCol,
-          uint8_t id);
     /** Determines the token type */
-    TokenType Type;
-    /** Determines the index of the token string in the source file */
-    uint32_t Index = 0;
-    /** Determines the size of the token string in the source file */
-    uint32_t Size = 0;
-    /** Determines the line row of the token in the source file */
-    uint32_t LineRow = 0;
-    /** Determines the line column of the token in the source file */
-    uint32_t LineCol = 0;
+    TokenType Type = TokenType::END_OF_FILE;
     /**
      * Tag is either used to "tag" the token with instruction index or register
-     * id. This happens in the scanning phase
+     * id or number tokens with TAG_LITERAL_*. This happens in the scanning
+     * phase
      */
     uint8_t Tag = 0;
+    /** Determines the index of the token string in the source file */
+    uint32_t Index = 0;
+    /** Determines the size of the token string in the source file */
+    uint32_t Size = 0;
+    /** Decoded value if the token is an integer or float number */
+    Literal Value;
+};
+
+/**
+ * Type and tag of a token packed into 2 bytes
+ */
+struct TokenKind {
+    TokenType Type;
+    uint8_t Tag;
+};
+
+/**
+ * Position of a token string in the source file
+ */
+struct TokenSpan {
+    uint32_t Index;
+    uint32_t Size;
+};
+
+/**
+ * Stores the tokens of a source file as a structure of arrays. Every token
+ * takes up 10 bytes, the parser mostly looks at the token types which are
+ * densely packed in their own array. The values of number tokens are stored
+ * in a separate literal table in the same order as the number tokens appear
+ */
+class TokenStream {
+  public:
+    void push(TokenType type, uint8_t tag, uint32_t index, uint32_t size);
+    void pushLiteral(TokenType type,
+                     uint8_t tag,
+                     uint32_t index,
+                     uint32_t size,
+                     Literal value);
+    void append(const TokenStream& other);
+    void clear();
+    Token get(size_t index) const;
+    TokenType getType(size_t index) const;
+    Literal getLiteral(size_t index) const;
+    size_t size() const;
+    bool empty() const;
+
+  private:
+    /** Type and tag of every token */
+    std::vector<TokenKind> Kinds;
+    /** Source file position of every token */
+    std::vector<TokenSpan> Spans;
+    /** Decoded value of every number token */
+    std::vector<Literal> Literals;
 };